@@ -0,0 +1,108 @@
+import std;
+
+import text_arena;
+
+import types;
+import arm_instruction;
+import disassembly;
+
+import benchmark_harness;
+import benchmark_workload;
+
+/*
+	Format detection and decode + format cost of every instruction Format, optionally with
+	hardware counters (--counters)
+*/
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+using dzl::fmt::arm::Format;
+
+constexpr std::size_t words_per_format{4096};
+
+auto measure_words(std::vector<dzl::bench::Result>& t_results, const std::string_view t_name,
+				   const std::span<const dzl::Word> t_words, dzl::bench::PerfCounters* t_counters)
+	-> void
+{
+	const dzl::bench::Options options{.instructions_per_iteration = t_words.size(),
+									  .counters = t_counters};
+
+	t_results.push_back(dzl::bench::measure(
+		std::format("get_format {}", t_name),
+		[&]
+		{
+			for (const auto word : t_words)
+			{
+				dzl::bench::do_not_optimize(dzl::fmt::arm::get_format(word));
+			}
+		},
+		options));
+
+	TextArena text;
+	t_results.push_back(dzl::bench::measure(
+		std::format("decode + format {}", t_name),
+		[&]
+		{
+			text.reset();
+			for (const auto word : t_words)
+			{
+				dzl::bench::do_not_optimize(
+					dzl::format_decoded(dzl::fmt::arm::try_decode(word), word, text));
+			}
+		},
+		options));
+}
+
+} // namespace
+
+auto main(const int t_argument_count, const char** t_arguments) -> int
+{
+	const std::span<const char* const> arguments(t_arguments,
+												 static_cast<std::size_t>(t_argument_count));
+	const auto use_counters{std::ranges::contains(arguments | std::views::drop(1),
+												  std::string_view("--counters"))};
+
+	try
+	{
+		std::optional<dzl::bench::PerfCounters> counters;
+		if (use_counters)
+		{
+			counters.emplace();
+			if (!counters->available())
+			{
+				std::println(std::cerr, "Hardware counters unavailable ({}), reporting time only",
+							 counters->error());
+			}
+			else if (!counters->error().empty())
+			{
+				std::println(std::cerr, "Some hardware counters unavailable ({})", counters->error());
+			}
+		}
+		auto* const counters_pointer{counters && counters->available() ? &*counters : nullptr};
+
+		std::mt19937 generator(dzl::bench::workload_seed);
+		std::vector<dzl::bench::Result> results;
+
+		for (std::size_t i_format{}; i_format < dzl::fmt::arm::format_count; ++i_format)
+		{
+			const auto format{static_cast<Format>(i_format)};
+			measure_words(results, dzl::fmt::arm::format_name(format),
+						  dzl::bench::make_words(format, words_per_format, generator),
+						  counters_pointer);
+		}
+
+		measure_words(results, "(all formats)", dzl::bench::make_mixed_words(words_per_format),
+					  counters_pointer);
+
+		dzl::bench::print(results);
+	}
+	catch (const std::exception& error)
+	{
+		std::println(std::cerr, "{}", error.what());
+		return 1;
+	}
+}
+
+// NOLINTEND(*-magic-numbers)
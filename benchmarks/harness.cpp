@@ -0,0 +1,148 @@
+export module benchmark_harness;
+
+import std;
+
+import allocation_counter;
+
+export import perf_counters;
+
+namespace dzl::bench
+{
+export struct Options
+{
+	std::chrono::nanoseconds min_time{std::chrono::milliseconds(200)};
+	// Instructions handled by one call, results are also reported per instruction
+	std::size_t instructions_per_iteration{1};
+	// Read around every timed run when set
+	PerfCounters* counters{};
+};
+
+export struct Result
+{
+	std::string name;
+	std::size_t iterations;
+	std::chrono::nanoseconds elapsed;
+	std::size_t instructions_per_iteration{1};
+	// Totals over the reported run
+	CounterValues counters{};
+	// One further call, when the build counts allocations
+	std::optional<memory::AllocationCount> allocations;
+
+	[[nodiscard]] auto nanoseconds_per_iteration() const noexcept
+	{
+		return static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+	}
+
+	[[nodiscard]] auto nanoseconds_per_instruction() const noexcept
+	{
+		return nanoseconds_per_iteration() / static_cast<double>(instructions_per_iteration);
+	}
+
+	[[nodiscard]] auto per_instruction(const Counter t_counter) const -> std::optional<double>
+	{
+		const auto instructions{static_cast<double>(iterations * instructions_per_iteration)};
+		return counters[static_cast<std::size_t>(t_counter)].transform(
+			[&](const double t_total) { return t_total / instructions; });
+	}
+};
+
+// Keeps a result the compiler could otherwise prove unused
+export template <typename Type> auto do_not_optimize(const Type& t_value) -> void
+{
+	asm volatile("" : : "r,m"(t_value) : "memory");
+}
+
+/*
+	Runs t_function once to warm up, then doubles the iteration count until a run takes at least
+	t_options.min_time
+*/
+export template <std::invocable Function>
+[[nodiscard]] auto measure(std::string t_name, Function&& t_function, const Options& t_options = {})
+{
+	using Clock = std::chrono::steady_clock;
+
+	t_function();
+
+	for (std::size_t iterations{1};; iterations *= 2)
+	{
+		if (t_options.counters != nullptr)
+		{
+			t_options.counters->start();
+		}
+
+		const auto start{Clock::now()};
+		for (std::size_t i_iteration{}; i_iteration < iterations; ++i_iteration)
+		{
+			t_function();
+		}
+		const auto elapsed{std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start)};
+
+		const auto counters{t_options.counters != nullptr ? t_options.counters->stop()
+														  : CounterValues{}};
+
+		if (elapsed >= t_options.min_time)
+		{
+			Result result{.name = std::move(t_name),
+						  .iterations = iterations,
+						  .elapsed = elapsed,
+						  .instructions_per_iteration = t_options.instructions_per_iteration,
+						  .counters = counters,
+						  .allocations = std::nullopt};
+
+			if constexpr (memory::allocation_counting)
+			{
+				result.allocations = memory::count_allocations(t_function);
+			}
+			return result;
+		}
+	}
+}
+
+export auto print(const std::span<const Result> t_results) -> void
+{
+	const auto name_width{std::ranges::max(t_results | std::views::transform(
+														   [](const Result& t_result)
+														   { return t_result.name.size(); }))};
+
+	for (const auto& result : t_results)
+	{
+		if (result.instructions_per_iteration == 1)
+		{
+			std::println("{:<{}}  {:>12.1f} ns/iteration  ({} iterations)", result.name, name_width,
+						 result.nanoseconds_per_iteration(), result.iterations);
+		}
+		else
+		{
+			std::println("{:<{}}  {:>12.1f} ns/iteration  {:>8.2f} ns/instruction  ({} iterations)",
+						 result.name, name_width, result.nanoseconds_per_iteration(),
+						 result.nanoseconds_per_instruction(), result.iterations);
+		}
+
+		if (result.allocations)
+		{
+			const auto instructions{static_cast<double>(result.instructions_per_iteration)};
+			const auto [allocations, deallocations, bytes]{*result.allocations};
+			std::println("{:<{}}  allocations {:.3f}  bytes {:.1f}  (per instruction)", "",
+						 name_width, static_cast<double>(allocations) / instructions,
+						 static_cast<double>(bytes) / instructions);
+		}
+
+		if (std::ranges::none_of(result.counters, [](const std::optional<double>& t_value)
+								 { return t_value.has_value(); }))
+		{
+			continue;
+		}
+
+		// Counters per instruction, or per iteration when one iteration is one instruction
+		std::string counters;
+		for (std::size_t i_counter{}; i_counter < counter_count; ++i_counter)
+		{
+			const auto value{result.per_instruction(static_cast<Counter>(i_counter))};
+			std::format_to(std::back_inserter(counters), "  {} {}", counter_names[i_counter],
+						   value ? std::format("{:.3f}", *value) : "n/a");
+		}
+		std::println("{:<{}}{}", "", name_width, counters);
+	}
+}
+
+} // namespace dzl::bench
@@ -0,0 +1,102 @@
+#include "armdis.h"
+
+import std;
+
+import benchmark_harness;
+
+/*
+	Per-call cost of the shared library against spawning the command line tool for the same
+	small request
+*/
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+constexpr std::array<std::uint32_t, 16> words{
+	0xE92D'4010, 0xE3A0'0000, 0xE280'0001, 0xE350'000A, 0x1AFF'FFFC, 0xE1A0'1000,
+	0xE081'1002, 0xE351'0FFF, 0x03A0'0001, 0x13A0'0000, 0xE10F'0000, 0xE128'F000,
+	0xEB00'0004, 0xE12F'FF1E, 0xE8BD'8010, 0xE1A0'F00E};
+
+auto require(const armdis_status t_status) -> void
+{
+	if (t_status != ARMDIS_OK)
+	{
+		throw std::runtime_error(armdis_status_string(t_status));
+	}
+}
+
+} // namespace
+
+auto main(const int t_argument_count, const char** t_arguments) -> int
+{
+	const std::span<const char* const> arguments(t_arguments,
+												 static_cast<std::size_t>(t_argument_count));
+	const std::string_view cli(arguments.size() > 1 ? arguments[1] : ARM_DISASSEMBLER_CLI);
+
+	try
+	{
+		std::vector<dzl::bench::Result> results;
+
+		std::array<armdis_insn, words.size()> instructions{};
+		std::array<char, 4096> text{};
+		std::size_t written{};
+
+		results.push_back(dzl::bench::measure(
+			"armdis_decode",
+			[&] { require(armdis_decode(words.data(), words.size(), instructions.data())); }));
+
+		results.push_back(dzl::bench::measure(
+			"armdis_decode + armdis_format",
+			[&]
+			{
+				require(armdis_decode(words.data(), words.size(), instructions.data()));
+				require(armdis_format(instructions.data(), instructions.size(), text.data(),
+									  text.size(), &written));
+			}));
+
+		results.push_back(dzl::bench::measure(
+			"armdis_disassemble",
+			[&]
+			{
+				require(armdis_disassemble(words.data(), words.size(), text.data(), text.size(),
+										   &written));
+			}));
+
+		// The same words as an image for the command line tool
+		const auto image{std::filesystem::temp_directory_path() / "armdis_benchmark.bin"};
+		{
+			std::ofstream file(image, std::ios::binary);
+			file.write(reinterpret_cast<const char*>(words.data()),
+					   static_cast<std::streamsize>(sizeof(words)));
+		}
+
+#if defined(_WIN32)
+		constexpr std::string_view null_device{"NUL"};
+#else
+		constexpr std::string_view null_device{"/dev/null"};
+#endif
+		const auto command{std::format("\"{}\" \"{}\" > {}", cli, image.string(), null_device)};
+		results.push_back(dzl::bench::measure(
+			"arm_disassembler process",
+			[&]
+			{
+				if (std::system(command.c_str()) != 0)
+				{
+					throw std::runtime_error(std::format("Failed to run {}", cli));
+				}
+			},
+			{.min_time = std::chrono::seconds(1)}));
+
+		std::filesystem::remove(image);
+
+		dzl::bench::print(results);
+	}
+	catch (const std::exception& error)
+	{
+		std::println(std::cerr, "{}", error.what());
+		return 1;
+	}
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,163 @@
+module;
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+export module perf_counters;
+
+import std;
+
+namespace dzl::bench
+{
+export enum struct Counter : std::uint8_t
+{
+	Cycles,
+	Instructions,
+	BranchMisses,
+	L1DataMisses,
+	LastLevelCacheMisses
+};
+
+export constexpr std::size_t counter_count{5};
+
+export constexpr std::array<std::string_view, counter_count> counter_names{
+	"cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"};
+
+// Counts over one measured region, std::nullopt where the counter is unavailable
+export using CounterValues = std::array<std::optional<double>, counter_count>;
+
+/*
+	User-space hardware counters of the calling thread, through perf_event_open on Linux. Counters
+	that cannot be opened (no PMU in a virtual machine, perf_event_paranoid, other platforms) are
+	reported as unavailable instead of failing the benchmark.
+*/
+export class PerfCounters
+{
+public:
+	PerfCounters()
+	{
+#if defined(__linux__)
+		constexpr auto cache_miss{[](const std::uint64_t t_cache) -> std::uint64_t
+								  {
+									  return t_cache | (PERF_COUNT_HW_CACHE_OP_READ << 8U) |
+											 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16U);
+								  }};
+
+		constexpr std::array<std::pair<std::uint32_t, std::uint64_t>, counter_count> events{{
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+			{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+			{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+		}};
+
+		for (std::size_t i_counter{}; i_counter < counter_count; ++i_counter)
+		{
+			perf_event_attr attributes{};
+			attributes.size = sizeof(attributes);
+			attributes.type = events[i_counter].first;
+			attributes.config = events[i_counter].second;
+			attributes.disabled = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			m_descriptors[i_counter] =
+				static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+			if (m_descriptors[i_counter] < 0 && m_error.empty())
+			{
+				m_error = std::format("{}: {}", counter_names[i_counter], std::strerror(errno));
+			}
+		}
+#else
+		m_error = "perf_event_open is only available on Linux";
+#endif
+	}
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters(PerfCounters&&) = delete;
+	auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+	auto operator=(PerfCounters&&) -> PerfCounters& = delete;
+
+	~PerfCounters()
+	{
+#if defined(__linux__)
+		for (const auto descriptor : m_descriptors | std::views::filter(is_open))
+		{
+			close(descriptor);
+		}
+#endif
+	}
+
+	[[nodiscard]] auto available() const noexcept
+	{
+		return std::ranges::any_of(m_descriptors, is_open);
+	}
+
+	// First counter that failed to open, empty when all of them are available
+	[[nodiscard]] auto error() const noexcept -> std::string_view
+	{
+		return m_error;
+	}
+
+	auto start() -> void
+	{
+#if defined(__linux__)
+		for (const auto descriptor : m_descriptors | std::views::filter(is_open))
+		{
+			ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+			ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	[[nodiscard]] auto stop() -> CounterValues
+	{
+		CounterValues values{};
+#if defined(__linux__)
+		for (const auto descriptor : m_descriptors | std::views::filter(is_open))
+		{
+			ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+		}
+
+		for (std::size_t i_counter{}; i_counter < counter_count; ++i_counter)
+		{
+			if (!is_open(m_descriptors[i_counter]))
+			{
+				continue;
+			}
+
+			// Value, time enabled and time running
+			std::array<std::uint64_t, 3> sample{};
+			const auto read_size{read(m_descriptors[i_counter], sample.data(), sizeof(sample))};
+			const auto [value, enabled, running]{sample};
+			if (read_size != static_cast<ssize_t>(sizeof(sample)) || running == 0)
+			{
+				continue;
+			}
+
+			// Scaled up when the kernel multiplexed the counter with others
+			values[i_counter] = static_cast<double>(value) *
+								(static_cast<double>(enabled) / static_cast<double>(running));
+		}
+#endif
+		return values;
+	}
+
+private:
+	constexpr static auto is_open(const int t_descriptor) noexcept -> bool
+	{
+		return t_descriptor >= 0;
+	}
+
+	std::array<int, counter_count> m_descriptors{-1, -1, -1, -1, -1};
+	std::string m_error;
+};
+
+} // namespace dzl::bench
@@ -0,0 +1,237 @@
+import std;
+
+import text_arena;
+
+import types;
+import arm_instruction;
+import disassembly;
+
+import benchmark_harness;
+import benchmark_workload;
+
+/*
+	Performance regression gate. Times a fixed decode and decode + format workload and compares
+	ns/instruction with the baseline recorded on the same machine class, failing when either is
+	slower than the baseline by more than the threshold. With --update, the baseline is rewritten
+	from this run instead.
+
+	perf_regression --baseline <file> [--threshold <percent>] [--update]
+*/
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+constexpr std::size_t words_per_format{2048};
+constexpr std::size_t repetitions{5};
+
+// Reported by ctest as skipped rather than failed
+constexpr int missing_baseline_exit_code{77};
+
+struct Options
+{
+	std::filesystem::path baseline;
+	double threshold{10.0};
+	bool update{};
+};
+
+auto parse_options(const std::span<const char* const> t_arguments) -> Options
+{
+	Options options;
+	for (std::size_t i_argument{1}; i_argument < t_arguments.size(); ++i_argument)
+	{
+		const std::string_view argument(t_arguments[i_argument]);
+		const auto has_value{i_argument + 1 < t_arguments.size()};
+
+		if (argument == "--baseline" && has_value)
+		{
+			options.baseline = t_arguments[++i_argument];
+		}
+		else if (argument == "--threshold" && has_value)
+		{
+			const std::string_view value(t_arguments[++i_argument]);
+			const auto [end, error]{
+				std::from_chars(value.data(), value.data() + value.size(), options.threshold)};
+			if (error != std::errc() || end != value.data() + value.size() ||
+				options.threshold < 0.0)
+			{
+				throw std::invalid_argument(std::format("Invalid threshold: {}", value));
+			}
+		}
+		else if (argument == "--update")
+		{
+			options.update = true;
+		}
+		else
+		{
+			throw std::invalid_argument(std::format("Unknown argument: {}", argument));
+		}
+	}
+
+	if (options.baseline.empty())
+	{
+		throw std::invalid_argument("Usage: perf_regression --baseline <file> "
+									"[--threshold <percent>] [--update]");
+	}
+	return options;
+}
+
+// Nanoseconds per instruction by workload
+using Measurements = std::map<std::string, double, std::less<>>;
+
+// One "<workload> <ns/instruction>" per line, '#' starts a comment
+auto read_baseline(const std::filesystem::path& t_path) -> std::optional<Measurements>
+{
+	std::ifstream file(t_path);
+	if (!file)
+	{
+		return std::nullopt;
+	}
+
+	Measurements baseline;
+	for (std::string line; std::getline(file, line);)
+	{
+		if (line.empty() || line.starts_with('#'))
+		{
+			continue;
+		}
+
+		std::istringstream fields(line);
+		std::string name;
+		double nanoseconds{};
+		if (!(fields >> name >> nanoseconds))
+		{
+			throw std::runtime_error(std::format("Malformed baseline line in {}: {}",
+												 t_path.string(), line));
+		}
+		baseline[name] = nanoseconds;
+	}
+	return baseline;
+}
+
+auto write_baseline(const std::filesystem::path& t_path, const Measurements& t_measurements)
+	-> void
+{
+	if (t_path.has_parent_path())
+	{
+		std::filesystem::create_directories(t_path.parent_path());
+	}
+
+	std::ofstream file(t_path);
+	std::println(file, "# ns/instruction, rewritten by the perf_baseline target");
+	for (const auto& [name, nanoseconds] : t_measurements)
+	{
+		std::println(file, "{} {:.3f}", name, nanoseconds);
+	}
+
+	if (!file)
+	{
+		throw std::runtime_error(std::format("Cannot write {}", t_path.string()));
+	}
+}
+
+// Fastest of several runs, being the least disturbed by other load on the machine
+auto fastest(const std::string_view t_name, const std::size_t t_instructions,
+			 const std::invocable auto& t_function) -> double
+{
+	auto best{std::numeric_limits<double>::infinity()};
+	for (std::size_t i_repetition{}; i_repetition < repetitions; ++i_repetition)
+	{
+		const auto result{dzl::bench::measure(
+			std::string(t_name), t_function,
+			{.min_time = std::chrono::milliseconds(100), .instructions_per_iteration = t_instructions})};
+		best = std::min(best, result.nanoseconds_per_instruction());
+	}
+	return best;
+}
+
+auto measure_workloads() -> Measurements
+{
+	const auto words{dzl::bench::make_mixed_words(words_per_format)};
+	TextArena text;
+
+	return {
+		{"decode", fastest("decode", words.size(),
+						   [&]
+						   {
+							   for (const auto word : words)
+							   {
+								   dzl::bench::do_not_optimize(dzl::fmt::arm::try_decode(word));
+							   }
+						   })},
+		{"decode_format", fastest("decode_format", words.size(),
+								  [&]
+								  {
+									  text.reset();
+									  for (const auto word : words)
+									  {
+										  dzl::bench::do_not_optimize(dzl::format_decoded(
+											  dzl::fmt::arm::try_decode(word), word, text));
+									  }
+								  })},
+	};
+}
+
+} // namespace
+
+auto main(const int t_argument_count, const char** t_arguments) -> int
+{
+	try
+	{
+		const auto options{parse_options(
+			std::span<const char* const>(t_arguments, static_cast<std::size_t>(t_argument_count)))};
+
+		if (options.update)
+		{
+			const auto measurements{measure_workloads()};
+			write_baseline(options.baseline, measurements);
+			for (const auto& [name, nanoseconds] : measurements)
+			{
+				std::println("{:<14} {:>8.3f} ns/instruction", name, nanoseconds);
+			}
+			std::println("Baseline written to {}", options.baseline.string());
+			return 0;
+		}
+
+		const auto baseline{read_baseline(options.baseline)};
+		if (!baseline)
+		{
+			std::println("No baseline at {}, record one with the perf_baseline target",
+						 options.baseline.string());
+			return missing_baseline_exit_code;
+		}
+
+		// Only measured once there is something to compare with
+		const auto measurements{measure_workloads()};
+
+		auto regressed{false};
+		for (const auto& [name, nanoseconds] : measurements)
+		{
+			const auto recorded{baseline->find(name)};
+			if (recorded == baseline->end())
+			{
+				std::println("{:<14} {:>8.3f} ns/instruction  (not in the baseline)", name,
+							 nanoseconds);
+				continue;
+			}
+
+			const auto change{((nanoseconds / recorded->second) - 1.0) * 100.0};
+			const auto failed{change > options.threshold};
+			regressed = regressed || failed;
+
+			std::println("{:<14} {:>8.3f} ns/instruction  baseline {:>8.3f}  {:+6.1f}%{}", name,
+						 nanoseconds, recorded->second, change,
+						 failed ? std::format("  exceeds the {}% threshold", options.threshold)
+								: "");
+		}
+
+		return regressed ? 1 : 0;
+	}
+	catch (const std::exception& error)
+	{
+		std::println(std::cerr, "{}", error.what());
+		return 1;
+	}
+}
+
+// NOLINTEND(*-magic-numbers)
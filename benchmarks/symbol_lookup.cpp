@@ -0,0 +1,106 @@
+import std;
+
+import types;
+import symbol_table;
+
+import benchmark_harness;
+
+/*
+	Symbolizing branch targets against an image sized symbol table: std::map, binary search over a
+	sorted array and the Eytzinger layout of SymbolTable
+*/
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+constexpr std::size_t symbol_count{200'000};
+constexpr std::size_t lookup_count{1'000'000};
+
+// Functions of 16 to 1024 bytes from 0x8000 on
+auto make_symbols(std::mt19937& t_generator)
+{
+	std::uniform_int_distribution<std::uint32_t> function_words(4, 256);
+
+	std::vector<std::pair<std::uint32_t, std::string>> symbols;
+	std::uint32_t address{0x8000};
+	for (std::size_t i_symbol{}; i_symbol < symbol_count; ++i_symbol)
+	{
+		symbols.emplace_back(address, std::format("function_{}", i_symbol));
+		address += 4 * function_words(t_generator);
+	}
+	return symbols;
+}
+
+} // namespace
+
+auto main() -> int
+{
+	try
+	{
+		std::mt19937 generator(1729);
+		const auto symbols{make_symbols(generator)};
+
+		std::uniform_int_distribution<std::uint32_t> addresses(0x8000, symbols.back().first + 0x400);
+		std::vector<dzl::Address> targets;
+		targets.reserve(lookup_count);
+		for (std::size_t i_lookup{}; i_lookup < lookup_count; ++i_lookup)
+		{
+			targets.emplace_back(addresses(generator) & ~3U);
+		}
+
+		const std::map<std::uint32_t, std::string_view> map(symbols.begin(), symbols.end());
+
+		std::vector<std::uint32_t> sorted_addresses;
+		std::vector<dzl::symbols::Symbol> table_symbols;
+		for (const auto& [address, name] : symbols)
+		{
+			sorted_addresses.push_back(address);
+			table_symbols.push_back({.address = dzl::Address(address), .name = name});
+		}
+		const dzl::symbols::SymbolTable table(table_symbols);
+
+		const dzl::bench::Options options{.instructions_per_iteration = lookup_count};
+		const std::array results{
+			dzl::bench::measure("std::map",
+								[&]
+								{
+									for (const auto target : targets)
+									{
+										dzl::bench::do_not_optimize(
+											std::prev(map.upper_bound(target.get()))->second);
+									}
+								},
+								options),
+			dzl::bench::measure("sorted array",
+								[&]
+								{
+									for (const auto target : targets)
+									{
+										dzl::bench::do_not_optimize(
+											std::ranges::upper_bound(sorted_addresses, target.get()) -
+											sorted_addresses.begin());
+									}
+								},
+								options),
+			dzl::bench::measure("SymbolTable",
+								[&]
+								{
+									for (const auto target : targets)
+									{
+										dzl::bench::do_not_optimize(table.find(target));
+									}
+								},
+								options),
+		};
+
+		dzl::bench::print(results);
+	}
+	catch (const std::exception& error)
+	{
+		std::println(std::cerr, "{}", error.what());
+		return 1;
+	}
+}
+
+// NOLINTEND(*-magic-numbers)
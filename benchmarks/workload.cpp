@@ -0,0 +1,60 @@
+export module benchmark_workload;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import arm_instruction;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::bench
+{
+/*
+	Deterministic instruction corpora, the same on every run and machine
+*/
+using fmt::arm::Format;
+
+export constexpr std::uint32_t workload_seed{1729};
+
+// Random words with the format's required bits, kept only if no earlier format claims them
+export auto make_words(const Format t_format, const std::size_t t_count,
+					   std::mt19937& t_generator) -> std::vector<Word>
+{
+	const auto [checked_bits, required_bits]{fmt::arm::format_mask(t_format)};
+
+	std::vector<Word> words;
+	words.reserve(t_count);
+	while (words.size() < t_count)
+	{
+		const Word random(static_cast<std::uint32_t>(t_generator()));
+		const auto word{(random & ~checked_bits) | required_bits};
+		if (fmt::arm::get_format(word) == t_format)
+		{
+			words.push_back(word);
+		}
+	}
+	return words;
+}
+
+// t_words_per_format of every format, interleaved so that the next format is unpredictable
+export auto make_mixed_words(const std::size_t t_words_per_format) -> std::vector<Word>
+{
+	std::mt19937 generator(workload_seed);
+
+	std::vector<Word> words;
+	for (std::size_t i_format{}; i_format < fmt::arm::format_count; ++i_format)
+	{
+		const auto format_words{make_words(static_cast<Format>(i_format), t_words_per_format,
+										   generator)};
+		words.insert(words.end(), format_words.begin(), format_words.end());
+	}
+
+	std::ranges::shuffle(words, generator);
+	return words;
+}
+
+} // namespace dzl::bench
+
+// NOLINTEND(*-magic-numbers)
@@ -15,7 +15,7 @@ import instruction;
 
 namespace dzl::fmt::arm
 {
-struct FormatMask
+export struct FormatMask
 {
 	Word checked_bits, required_bits;
 };
@@ -75,7 +75,7 @@ static_assert(std::ranges::is_sorted(format_masks,
 												std::popcount(t_second.checked_bits.get());
 									 }));
 
-enum struct Format : Unsigned<1>::Underlying{BranchAndExchange,
+export enum struct Format : Unsigned<1>::Underlying{BranchAndExchange,
 											 SingleDataSwap,
 											 Multiply,
 											 HalfwordDataTransferRegsiterOffset,
@@ -91,6 +91,35 @@ enum struct Format : Unsigned<1>::Underlying{BranchAndExchange,
 											 DataProcessingPsrTransfer,
 											 SingleDataTransfer};
 
+export constexpr std::size_t format_count{format_masks.size()};
+
+export [[nodiscard]] constexpr auto format_name(const Format t_format) noexcept
+{
+	constexpr static std::array<std::string_view, format_count> names{
+		"BranchAndExchange",
+		"SingleDataSwap",
+		"Multiply",
+		"HalfwordDataTransferRegisterOffset",
+		"MultiplyLong",
+		"HalfwordDataTransferImmediateOffset",
+		"CoprocessorDataOperation",
+		"CoprocessorRegisterTransfer",
+		"Undefined",
+		"SoftwareInterrupt",
+		"BlockDataTransfer",
+		"Branch",
+		"CoprocessorDataTransfer",
+		"DataProcessingPsrTransfer",
+		"SingleDataTransfer"};
+
+	return names[static_cast<std::size_t>(t_format)];
+}
+
+export [[nodiscard]] constexpr auto format_mask(const Format t_format) noexcept
+{
+	return format_masks[static_cast<std::size_t>(t_format)];
+}
+
 [[nodiscard]] constexpr auto decode_branch_and_exchange(const Word t_raw_instruction) noexcept
 {
 	using BranchAndExchange = PackedStruct<Word,						  //
@@ -234,7 +263,7 @@ decode_data_processing_second_operand(const Word t_raw_instruction) noexcept
 																			 : Register::Cpsr};
 		const auto flags_only{first == Register::R8};
 
-		const ins::MoveToPsr instruction(ins::Operation::MoveFromPsr, condition, destination_psr,
+		const ins::MoveToPsr instruction(ins::Operation::MoveToPsr, condition, destination_psr,
 										 second, flags_only);
 		return ins::Instruction(instruction);
 	}
@@ -244,7 +273,7 @@ decode_data_processing_second_operand(const Word t_raw_instruction) noexcept
 	return ins::Instruction(instruction);
 }
 
-[[nodiscard]] constexpr auto get_format(const Word t_raw_instruction)
+export [[nodiscard]] constexpr auto get_format(const Word t_raw_instruction)
 {
 	for (std::size_t i_mask{}; i_mask < format_masks.size(); ++i_mask)
 	{
@@ -258,7 +287,9 @@ decode_data_processing_second_operand(const Word t_raw_instruction) noexcept
 	throw std::runtime_error("Invalid format");
 }
 
-export [[nodiscard]] constexpr auto decode(const Word t_raw_instruction)
+// Returns std::nullopt for formats that cannot be decoded yet
+export [[nodiscard]] constexpr auto try_decode(const Word t_raw_instruction)
+	-> std::optional<ins::Instruction>
 {
 	switch (get_format(t_raw_instruction))
 	{
@@ -274,20 +305,31 @@ export [[nodiscard]] constexpr auto decode(const Word t_raw_instruction)
 	case Format::Undefined:
 	case Format::SoftwareInterrupt:
 	case Format::BlockDataTransfer:
-		throw std::runtime_error("Format not implemented");
+		return std::nullopt;
 	case Format::Branch:
 		return decode_branch(t_raw_instruction);
 	case Format::CoprocessorDataTransfer:
-		throw std::runtime_error("Format not implemented");
+		return std::nullopt;
 	case Format::DataProcessingPsrTransfer:
 		return decode_data_processing_psr_transfer(t_raw_instruction);
 	case Format::SingleDataTransfer:
-		throw std::runtime_error("Format not implemented");
+		return std::nullopt;
 	default:
 		std::unreachable();
 	}
 }
 
+export [[nodiscard]] constexpr auto decode(const Word t_raw_instruction)
+{
+	const auto instruction{try_decode(t_raw_instruction)};
+	if (!instruction)
+	{
+		throw std::runtime_error("Format not implemented");
+	}
+
+	return *instruction;
+}
+
 } // namespace dzl::fmt::arm
 
 // NOLINTEND(*-magic-numbers)
\ No newline at end of file
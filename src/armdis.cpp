@@ -0,0 +1,155 @@
+#include "armdis.h"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import arm_instruction;
+import disassembly;
+
+namespace
+{
+// Reused between calls to avoid an allocation per call
+thread_local std::string text;
+
+// Decoded again from the word, bits from the caller are only compared, never interpreted
+[[nodiscard]] auto to_instruction(const armdis_insn& t_instruction)
+	-> std::optional<std::optional<dzl::ins::Instruction>>
+{
+	if (t_instruction.decoded == 0)
+	{
+		return std::optional<dzl::ins::Instruction>();
+	}
+
+	const auto instruction{dzl::fmt::arm::try_decode(dzl::Word(t_instruction.word))};
+	if (!instruction || instruction->to_underlying().get() != t_instruction.bits)
+	{
+		return std::nullopt;
+	}
+	return instruction;
+}
+
+[[nodiscard]] auto copy_text(char* const t_buffer, const std::size_t t_capacity,
+							 std::size_t* const t_written) noexcept
+{
+	*t_written = text.size();
+	if (text.size() >= t_capacity)
+	{
+		return ARMDIS_BUFFER_TOO_SMALL;
+	}
+
+	std::ranges::copy(text, t_buffer);
+	t_buffer[text.size()] = '\0';
+	return ARMDIS_OK;
+}
+
+// Runs t_function, turning every exception into a status
+[[nodiscard]] auto guarded(const std::invocable auto& t_function) noexcept -> armdis_status
+{
+	try
+	{
+		return t_function();
+	}
+	catch (...)
+	{
+		return ARMDIS_INTERNAL_ERROR;
+	}
+}
+
+} // namespace
+
+extern "C"
+{
+	armdis_status armdis_decode(const uint32_t* const words, const size_t count,
+								armdis_insn* const instructions)
+	{
+		if (count != 0 && (words == nullptr || instructions == nullptr))
+		{
+			return ARMDIS_INVALID_ARGUMENT;
+		}
+
+		return guarded(
+			[&]
+			{
+				const std::span input(words, count);
+				const std::span output(instructions, count);
+				for (std::size_t i_word{}; i_word < count; ++i_word)
+				{
+					const auto instruction{dzl::fmt::arm::try_decode(dzl::Word(input[i_word]))};
+					output[i_word] = armdis_insn{
+						.word = input[i_word],
+						.decoded = instruction ? 1U : 0U,
+						.bits = instruction ? instruction->to_underlying().get() : 0U,
+					};
+				}
+				return ARMDIS_OK;
+			});
+	}
+
+	armdis_status armdis_format(const armdis_insn* const instructions, const size_t count,
+								char* const buffer, const size_t capacity, size_t* const written)
+	{
+		if ((count != 0 && instructions == nullptr) || (capacity != 0 && buffer == nullptr) ||
+			written == nullptr)
+		{
+			return ARMDIS_INVALID_ARGUMENT;
+		}
+
+		return guarded(
+			[&]
+			{
+				text.clear();
+				for (const auto& instruction : std::span(instructions, count))
+				{
+					const auto decoded{to_instruction(instruction)};
+					if (!decoded)
+					{
+						return ARMDIS_INVALID_ARGUMENT;
+					}
+					dzl::format_decoded(*decoded, dzl::Word(instruction.word), text);
+				}
+				return copy_text(buffer, capacity, written);
+			});
+	}
+
+	armdis_status armdis_disassemble(const uint32_t* const words, const size_t count,
+									 char* const buffer, const size_t capacity,
+									 size_t* const written)
+	{
+		if ((count != 0 && words == nullptr) || (capacity != 0 && buffer == nullptr) ||
+			written == nullptr)
+		{
+			return ARMDIS_INVALID_ARGUMENT;
+		}
+
+		return guarded(
+			[&]
+			{
+				// Word has the layout of its underlying integer
+				const std::span input(reinterpret_cast<const dzl::Word*>(words), count);
+
+				text.clear();
+				dzl::disassemble(input, text);
+				return copy_text(buffer, capacity, written);
+			});
+	}
+
+	const char* armdis_status_string(const armdis_status status)
+	{
+		switch (status)
+		{
+		case ARMDIS_OK:
+			return "ok";
+		case ARMDIS_INVALID_ARGUMENT:
+			return "invalid argument";
+		case ARMDIS_BUFFER_TOO_SMALL:
+			return "buffer too small";
+		case ARMDIS_INTERNAL_ERROR:
+			return "internal error";
+		default:
+			return "unknown status";
+		}
+	}
+}
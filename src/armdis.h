@@ -0,0 +1,69 @@
+#ifndef ARMDIS_H
+#define ARMDIS_H
+
+/*
+	C interface to the disassembler
+
+	Every buffer is owned by the caller and every call reports failure through its return value,
+	exceptions never leave the library.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(ARMDIS_BUILDING)
+#define ARMDIS_API __declspec(dllexport)
+#else
+#define ARMDIS_API __declspec(dllimport)
+#endif
+#else
+#define ARMDIS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	typedef enum armdis_status
+	{
+		ARMDIS_OK = 0,
+		ARMDIS_INVALID_ARGUMENT = 1,
+		ARMDIS_BUFFER_TOO_SMALL = 2,
+		ARMDIS_INTERNAL_ERROR = 3
+	} armdis_status;
+
+	typedef struct armdis_insn
+	{
+		uint32_t word;
+		// Non-zero when the word could be decoded
+		uint32_t decoded;
+		// Packed instruction, only meaningful when decoded
+		uint64_t bits;
+	} armdis_insn;
+
+	// Decodes count words into instructions[0..count)
+	ARMDIS_API armdis_status armdis_decode(const uint32_t* words, size_t count,
+										   armdis_insn* instructions);
+
+	/*
+		Formats one line per instruction into buffer, NUL terminated. *written receives the
+		length of the text without the terminator, also when the buffer is too small, so the
+		call can be repeated with a large enough buffer. Instructions are decoded again from their
+		word, one whose bits do not match that decoding is an invalid argument.
+	*/
+	ARMDIS_API armdis_status armdis_format(const armdis_insn* instructions, size_t count,
+										   char* buffer, size_t capacity, size_t* written);
+
+	// Decodes and formats in one call, emitting words classified as data as .word directives
+	ARMDIS_API armdis_status armdis_disassemble(const uint32_t* words, size_t count, char* buffer,
+												size_t capacity, size_t* written);
+
+	ARMDIS_API const char* armdis_status_string(armdis_status status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
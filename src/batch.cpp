@@ -0,0 +1,349 @@
+export module batch;
+
+import std;
+
+import unsigned_integer;
+import thread_pool;
+
+import types;
+import image;
+import data_classifier;
+import disassembly;
+
+namespace dzl::batch
+{
+export struct Input
+{
+	std::filesystem::path path;
+
+	// Location of the listing, relative to the output directory
+	std::filesystem::path output;
+};
+
+export struct FileReport
+{
+	std::filesystem::path input;
+	std::size_t word_count;
+
+	// From the start of the first chunk until the listing has been written
+	std::chrono::nanoseconds elapsed;
+
+	// Why no listing was written, empty on success
+	std::string error;
+};
+
+// Files are split into chunks of at most this many words
+constexpr std::size_t chunk_word_count{1UZ << 18UZ};
+
+// Two inputs writing the same listing would overwrite each other
+auto check_unique_outputs(const std::span<const Input> t_inputs) -> void
+{
+	std::unordered_map<std::string, const Input*> outputs;
+	for (const auto& input : t_inputs)
+	{
+		const auto [existing, inserted]{outputs.try_emplace(input.output.generic_string(), &input)};
+		if (!inserted)
+		{
+			throw std::runtime_error(std::format("{} and {} would both be listed to {}.s",
+												 existing->second->path.string(),
+												 input.path.string(), input.output.string()));
+		}
+	}
+}
+
+/*
+	Inputs are either every regular file below a directory or the paths listed (one per line)
+	in a manifest file. Listed paths are written below the output directory as their relative
+	part, and may not leave it.
+*/
+export [[nodiscard]] auto collect_inputs(const std::filesystem::path& t_source)
+{
+	std::vector<Input> inputs;
+
+	if (std::filesystem::is_directory(t_source))
+	{
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(t_source))
+		{
+			if (entry.is_regular_file())
+			{
+				inputs.push_back({entry.path(), entry.path().lexically_relative(t_source)});
+			}
+		}
+
+		return inputs;
+	}
+
+	std::ifstream manifest(t_source);
+	if (!manifest)
+	{
+		throw std::runtime_error(std::format("Cannot open {}", t_source.string()));
+	}
+
+	for (std::string line; std::getline(manifest, line);)
+	{
+		if (line.empty())
+		{
+			continue;
+		}
+
+		const std::filesystem::path path(line);
+		const auto output{path.relative_path().lexically_normal()};
+		if (output.empty() || output == "." || *output.begin() == "..")
+		{
+			throw std::runtime_error(
+				std::format("{} would be listed outside the output directory", line));
+		}
+		inputs.push_back({path, output});
+	}
+
+	check_unique_outputs(inputs);
+	return inputs;
+}
+
+struct FileJob
+{
+	Input input;
+	std::size_t word_count{};
+
+	// Fed the chunks in file order, so that they are listed as they would be in one piece
+	std::mutex classifier_mutex;
+	search::StreamingClassifier classifier;
+	std::vector<bool> chunk_loaded;
+	std::size_t pushed_chunks{};
+	std::size_t ready_chunks{};
+
+	std::vector<std::vector<Word>> chunk_words;
+	std::vector<std::vector<search::WordKind>> chunk_kinds;
+	std::vector<std::string> chunk_texts;
+	std::vector<std::chrono::steady_clock::time_point> chunk_starts;
+	std::atomic<std::size_t> remaining_chunks;
+
+	// The first error skips the remaining chunks of the file
+	std::mutex error_mutex;
+	std::string error;
+	std::atomic<bool> failed;
+
+	auto fail(const std::string_view t_error) -> void
+	{
+		const std::scoped_lock lock(error_mutex);
+		if (!failed.exchange(true))
+		{
+			error = t_error;
+		}
+	}
+};
+
+/*
+	Classifies the chunks loaded so far that follow on from those already classified, and
+	returns the chunks whose kinds have become final. Once the file has failed, chunks are
+	returned as soon as the ones before them have been loaded.
+*/
+auto classify_loaded(FileJob& t_job, const std::size_t t_chunk) -> std::vector<std::size_t>
+{
+	const std::scoped_lock lock(t_job.classifier_mutex);
+	t_job.chunk_loaded[t_chunk] = true;
+
+	const auto chunk_count{t_job.chunk_loaded.size()};
+	try
+	{
+		for (; t_job.pushed_chunks < chunk_count && t_job.chunk_loaded[t_job.pushed_chunks];
+			 ++t_job.pushed_chunks)
+		{
+			if (!t_job.failed)
+			{
+				t_job.classifier.push(t_job.chunk_words[t_job.pushed_chunks]);
+			}
+		}
+
+		if (t_job.pushed_chunks == chunk_count && !t_job.failed)
+		{
+			t_job.classifier.finish();
+		}
+	}
+	catch (const std::exception& error)
+	{
+		t_job.fail(error.what());
+	}
+
+	std::vector<std::size_t> ready;
+	for (; t_job.ready_chunks < t_job.pushed_chunks; ++t_job.ready_chunks)
+	{
+		if (!t_job.failed)
+		{
+			const auto first_word{t_job.ready_chunks * chunk_word_count};
+			const auto end{first_word + t_job.chunk_words[t_job.ready_chunks].size()};
+			if (end > t_job.classifier.final_count())
+			{
+				break;
+			}
+
+			const auto kinds{t_job.classifier.kinds(first_word, end - first_word)};
+			t_job.chunk_kinds[t_job.ready_chunks].assign(kinds.begin(), kinds.end());
+			t_job.classifier.release(end);
+		}
+		ready.push_back(t_job.ready_chunks);
+	}
+	return ready;
+}
+
+auto write_listing(FileJob& t_job, const std::filesystem::path& t_output_directory) -> void
+{
+	auto path{t_output_directory / t_job.input.output};
+	path += ".s";
+	std::filesystem::create_directories(path.parent_path());
+
+	std::ofstream file(path, std::ios::binary);
+	for (auto& text : t_job.chunk_texts)
+	{
+		file.write(text.data(), static_cast<std::streamsize>(text.size()));
+		std::string().swap(text);
+	}
+
+	if (!file)
+	{
+		throw std::runtime_error(std::format("Cannot write {}", path.string()));
+	}
+}
+
+/*
+	Disassembles every input on one shared pool. Work is scheduled largest first, with large
+	files split into chunks so that they do not serialise the tail of the run. A file that
+	cannot be read or written is reported as failed, without stopping the others.
+*/
+export [[nodiscard]] auto run(const std::span<const Input> t_inputs,
+							  const std::filesystem::path& t_output_directory,
+							  const std::endian t_endianness, const std::size_t t_thread_count)
+{
+	std::vector<FileJob> jobs(t_inputs.size());
+	std::vector<FileReport> reports(t_inputs.size());
+
+	struct Chunk
+	{
+		std::size_t file;
+		std::size_t index;
+		std::size_t first_word;
+		std::size_t word_count;
+	};
+	std::vector<Chunk> chunks;
+
+	for (std::size_t i_file{}; i_file < t_inputs.size(); ++i_file)
+	{
+		auto& job{jobs[i_file]};
+		job.input = t_inputs[i_file];
+
+		std::error_code error;
+		const auto size{std::filesystem::file_size(job.input.path, error)};
+		if (error)
+		{
+			reports[i_file] = {.input = job.input.path,
+							   .word_count = 0,
+							   .elapsed = {},
+							   .error = error.message()};
+			continue;
+		}
+		job.word_count = static_cast<std::size_t>(size / sizeof(Word));
+
+		const auto chunk_count{std::max((job.word_count + chunk_word_count - 1) / chunk_word_count,
+										1UZ)};
+		job.chunk_loaded.resize(chunk_count);
+		job.chunk_words.resize(chunk_count);
+		job.chunk_kinds.resize(chunk_count);
+		job.chunk_texts.resize(chunk_count);
+		job.chunk_starts.resize(chunk_count);
+		job.remaining_chunks = chunk_count;
+
+		for (std::size_t i_chunk{}; i_chunk < chunk_count; ++i_chunk)
+		{
+			const auto first_word{i_chunk * chunk_word_count};
+			const auto word_count{std::min(chunk_word_count, job.word_count - first_word)};
+			chunks.push_back({i_file, i_chunk, first_word, word_count});
+		}
+	}
+
+	std::ranges::stable_sort(chunks, std::ranges::greater(), &Chunk::word_count);
+
+	ThreadPool pool(t_thread_count);
+
+	const auto disassemble_chunk{
+		[&](const std::size_t t_file, const std::size_t t_chunk)
+		{
+			auto& job{jobs[t_file]};
+
+			try
+			{
+				if (!job.failed)
+				{
+					disassemble(job.chunk_words[t_chunk], job.chunk_kinds[t_chunk],
+								job.chunk_texts[t_chunk]);
+				}
+			}
+			catch (const std::exception& error)
+			{
+				job.fail(error.what());
+			}
+			std::vector<Word>().swap(job.chunk_words[t_chunk]);
+			std::vector<search::WordKind>().swap(job.chunk_kinds[t_chunk]);
+
+			// The last chunk to finish writes the whole listing
+			if (job.remaining_chunks.fetch_sub(1) != 1)
+			{
+				return;
+			}
+
+			try
+			{
+				if (!job.failed)
+				{
+					write_listing(job, t_output_directory);
+				}
+			}
+			catch (const std::exception& error)
+			{
+				job.fail(error.what());
+			}
+			std::vector<std::string>().swap(job.chunk_texts);
+
+			const auto elapsed{std::chrono::steady_clock::now() -
+							   std::ranges::min(job.chunk_starts)};
+			reports[t_file] = FileReport{
+				.input = job.input.path,
+				.word_count = job.word_count,
+				.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed),
+				.error = job.error};
+		}};
+
+	for (const auto chunk : chunks)
+	{
+		pool.submit(
+			[&, chunk]
+			{
+				auto& job{jobs[chunk.file]};
+				job.chunk_starts[chunk.index] = std::chrono::steady_clock::now();
+
+				try
+				{
+					if (!job.failed)
+					{
+						job.chunk_words[chunk.index] = io::load_image(
+							job.input.path, t_endianness, chunk.first_word, chunk.word_count);
+					}
+				}
+				catch (const std::exception& error)
+				{
+					job.fail(error.what());
+				}
+
+				// Ahead of the remaining loads, so that loaded words do not pile up
+				for (const auto index : classify_loaded(job, chunk.index))
+				{
+					pool.submit_next([&, file = chunk.file, index]
+									 { disassemble_chunk(file, index); });
+				}
+			});
+	}
+	pool.wait();
+
+	return reports;
+}
+
+} // namespace dzl::batch
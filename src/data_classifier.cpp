@@ -0,0 +1,237 @@
+export module data_classifier;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import arm_instruction;
+import pattern_search;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::search
+{
+using fmt::arm::FormatMask;
+
+export enum struct WordKind : Unsigned<1>::Underlying{
+	Code,
+	Literal,   // Loaded pc-relative
+	Invalid,   // Never condition or undefined instruction
+	Unlikely}; // Conditional, among too few unconditional words
+
+export [[nodiscard]] constexpr auto is_data(const WordKind t_kind) noexcept
+{
+	return t_kind != WordKind::Code;
+}
+
+constexpr std::array invalid_masks{
+	// Never condition
+	FormatMask{.checked_bits = 0xF000'0000_u32, .required_bits = 0xF000'0000_u32},
+	// Undefined
+	FormatMask{.checked_bits = 0x0E00'0010_u32, .required_bits = 0x0600'0010_u32}};
+
+// ldr/ldrb rd, [pc, #+/-offset]
+constexpr std::array literal_load_masks{
+	FormatMask{.checked_bits = 0x0F3F'0000_u32, .required_bits = 0x051F'0000_u32}};
+
+/*
+	Code is mostly unconditional, while the condition field of data is close to arbitrary (and
+	zero for small constants). A window with fewer unconditional words than this is data.
+*/
+constexpr std::size_t window_word_count{8};
+constexpr std::size_t min_unconditional_count{2};
+
+[[nodiscard]] constexpr auto is_unconditional(const Word t_word) noexcept
+{
+	return (t_word.get() >> 28U) == static_cast<Word::Underlying>(Condition::Al);
+}
+
+[[nodiscard]] constexpr auto is_literal_load(const Word t_word) noexcept
+{
+	return std::ranges::any_of(literal_load_masks,
+							   [&](const FormatMask t_mask)
+							   {
+								   return (t_word.get() & t_mask.checked_bits.get()) ==
+										  t_mask.required_bits.get();
+							   });
+}
+
+/*
+	Literals lie within 4095 bytes of the pc, two words ahead of the load
+*/
+constexpr std::size_t literal_reach_ahead{1025};
+constexpr std::size_t literal_reach_behind{1022};
+
+// Index of the word loaded by t_load at t_index, if inside an image of t_word_count words
+[[nodiscard]] constexpr auto literal_target(const Word t_load, const std::size_t t_index,
+											const std::size_t t_word_count) noexcept
+	-> std::optional<std::size_t>
+{
+	const auto word{t_load.get()};
+	const auto offset{static_cast<std::int64_t>(word & 0xFFFU)};
+	const auto add{(word & 0x0080'0000U) != 0U};
+
+	// Relative to the pc, two words ahead
+	const auto target{static_cast<std::int64_t>((t_index + 2) * sizeof(Word)) +
+					  (add ? offset : -offset)};
+	if (target < 0 || std::cmp_greater_equal(target / 4, t_word_count))
+	{
+		return std::nullopt;
+	}
+	return static_cast<std::size_t>(target / 4);
+}
+
+// Everything but literals, which only depends on the words themselves
+[[nodiscard]] auto classify_words(const std::span<const Word> t_words) -> std::vector<WordKind>
+{
+	std::vector<WordKind> kinds(t_words.size(), WordKind::Code);
+
+	// Full windows only, the tail is too short to judge
+	for (std::size_t i_window{}; i_window + window_word_count <= t_words.size();
+		 i_window += window_word_count)
+	{
+		const auto window{t_words.subspan(i_window, window_word_count)};
+		const auto unconditional_count{std::ranges::count_if(window, is_unconditional)};
+		if (std::cmp_greater_equal(unconditional_count, min_unconditional_count))
+		{
+			continue;
+		}
+
+		for (std::size_t i_word{}; i_word < window_word_count; ++i_word)
+		{
+			if (!is_unconditional(window[i_word]))
+			{
+				kinds[i_window + i_word] = WordKind::Unlikely;
+			}
+		}
+	}
+
+	for (const auto [index, pattern] : find_matches(t_words, invalid_masks))
+	{
+		kinds[index] = WordKind::Invalid;
+	}
+
+	return kinds;
+}
+
+/*
+	Classifies each word as code or likely data
+*/
+export [[nodiscard]] auto classify(const std::span<const Word> t_words) -> std::vector<WordKind>
+{
+	auto kinds{classify_words(t_words)};
+
+	// Loads from words already classified as data are not trusted
+	for (const auto [index, pattern] : find_matches(t_words, literal_load_masks))
+	{
+		if (is_data(kinds[index]))
+		{
+			continue;
+		}
+
+		if (const auto target{literal_target(t_words[index], index, t_words.size())})
+		{
+			kinds[*target] = WordKind::Literal;
+		}
+	}
+
+	return kinds;
+}
+
+/*
+	Classifies an image pushed a chunk at a time, with the same result as classify() on the
+	whole image. Loads are processed in order once every word they may mark was pushed, and a
+	word's kind is final once no later load can reach it.
+*/
+export class StreamingClassifier
+{
+public:
+	// Only the last chunk may end inside a window
+	auto push(const std::span<const Word> t_words) -> void
+	{
+		if (m_finished || m_end % window_word_count != 0)
+		{
+			throw std::logic_error("Only the last chunk may end inside a window");
+		}
+
+		const auto kinds{classify_words(t_words)};
+		m_words.insert(m_words.end(), t_words.begin(), t_words.end());
+		m_kinds.insert(m_kinds.end(), kinds.begin(), kinds.end());
+		m_end += t_words.size();
+
+		if (m_end > literal_reach_ahead)
+		{
+			mark_literals(m_end - literal_reach_ahead);
+		}
+	}
+
+	// No more words, every kind is final
+	auto finish() -> void
+	{
+		m_finished = true;
+		mark_literals(m_end);
+	}
+
+	// Words before this index have their final kind
+	[[nodiscard]] auto final_count() const noexcept -> std::size_t
+	{
+		if (m_finished)
+		{
+			return m_end;
+		}
+		return m_next_load > literal_reach_behind ? m_next_load - literal_reach_behind : 0;
+	}
+
+	// Final kinds of words not released yet
+	[[nodiscard]] auto kinds(const std::size_t t_first, const std::size_t t_count) const
+		-> std::span<const WordKind>
+	{
+		if (t_first < m_first || t_first + t_count > final_count())
+		{
+			throw std::out_of_range("Kinds not final or already released");
+		}
+		return std::span(m_kinds).subspan(t_first - m_first, t_count);
+	}
+
+	// Forgets the final words before t_index
+	auto release(const std::size_t t_index) -> void
+	{
+		const auto count{std::min(t_index, final_count()) - std::min(t_index, m_first)};
+		m_words.erase(m_words.begin(), m_words.begin() + static_cast<std::ptrdiff_t>(count));
+		m_kinds.erase(m_kinds.begin(), m_kinds.begin() + static_cast<std::ptrdiff_t>(count));
+		m_first += count;
+	}
+
+private:
+	// Processes the loads before t_end
+	auto mark_literals(const std::size_t t_end) -> void
+	{
+		for (; m_next_load < t_end; ++m_next_load)
+		{
+			const auto load{m_words[m_next_load - m_first]};
+			if (!is_literal_load(load) || is_data(m_kinds[m_next_load - m_first]))
+			{
+				continue;
+			}
+
+			if (const auto target{literal_target(load, m_next_load, m_end)})
+			{
+				m_kinds[*target - m_first] = WordKind::Literal;
+			}
+		}
+	}
+
+	// From the image index m_first on
+	std::vector<Word> m_words;
+	std::vector<WordKind> m_kinds;
+	std::size_t m_first{};
+	std::size_t m_end{};
+
+	std::size_t m_next_load{};
+	bool m_finished{};
+};
+
+} // namespace dzl::search
+
+// NOLINTEND(*-magic-numbers)
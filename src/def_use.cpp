@@ -0,0 +1,258 @@
+export module def_use;
+
+import std;
+
+import unsigned_integer;
+import bit_manipulation;
+
+import types;
+import instruction;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl
+{
+/*
+	Register masks: bit n is rn, followed by the CPSR (bit 16) and the SPSR (bit 17)
+*/
+export struct DefUse
+{
+	std::uint32_t reads;
+	std::uint32_t writes;
+
+	constexpr auto operator==(const DefUse&) const -> bool = default;
+};
+
+export [[nodiscard]] constexpr auto register_mask(const Register t_register) noexcept
+{
+	return 1U << static_cast<unsigned>(t_register);
+}
+
+/*
+	Access tables
+
+	Every operation keeps its registers at fixed offsets of the packed instruction. A variant field
+	(op code, link bit, multiply flags...) selects which of them are read and written, and which
+	registers are accessed implicitly.
+*/
+struct Field
+{
+	std::uint8_t offset;
+	std::uint8_t size;
+};
+
+constexpr std::size_t max_register_fields{4};
+constexpr std::size_t max_variants{32};
+
+struct VariantAccess
+{
+	// Bit i selects register field i
+	std::uint8_t read_fields;
+	std::uint8_t write_fields;
+
+	std::uint32_t reads;
+	std::uint32_t writes;
+};
+
+struct OperationAccess
+{
+	std::array<Field, max_register_fields> registers;
+	Field variant;
+
+	// All set when bits 32-47 hold a shift operand
+	std::uint32_t shift_operand_mask;
+
+	std::array<VariantAccess, max_variants> variants;
+};
+
+constexpr auto pc_mask{register_mask(Register::Pc)};
+constexpr auto lr_mask{register_mask(Register::Lr)};
+constexpr auto cpsr_mask{register_mask(Register::Cpsr)};
+
+constexpr std::size_t operation_count{static_cast<std::size_t>(ins::Operation::Undefined) + 1};
+
+consteval auto make_operation_accesses()
+{
+	using enum ins::Operation;
+	using enum ins::DataProcessingOpCode;
+
+	std::array<OperationAccess, operation_count> table{};
+	const auto entry{[&](const ins::Operation t_operation) -> auto&
+					 { return table[static_cast<std::size_t>(t_operation)]; }};
+
+	// bx rm
+	auto& branch_and_exchange{entry(BranchAndExchange)};
+	branch_and_exchange.registers[0] = {32, 4};
+	branch_and_exchange.variants[0] = {0b1, 0, 0, pc_mask};
+
+	// b, bl: variant is the link bit
+	auto& branch{entry(Branch)};
+	branch.variant = {16, 1};
+	branch.variants[0] = {0, 0, pc_mask, pc_mask};
+	branch.variants[1] = {0, 0, pc_mask, pc_mask | lr_mask};
+
+	// Destination and first operand: variant is the op code and the set condition codes bit
+	auto& data_processing{entry(DataProcessing)};
+	data_processing.registers = {{{24, 4}, {28, 4}, {}, {}}};
+	data_processing.variant = {16, 5};
+	data_processing.shift_operand_mask = ~0U;
+	for (std::size_t i_variant{}; i_variant < max_variants; ++i_variant)
+	{
+		const auto op_code{static_cast<ins::DataProcessingOpCode>(i_variant & 0xFU)};
+		const auto set_condition_codes{(i_variant >> 4U) != 0U};
+
+		const auto is_comparison{op_code == Tst || op_code == Teq || op_code == Cmp ||
+								 op_code == Cmn};
+		const auto is_move{op_code == Mov || op_code == Mvn};
+		const auto reads_carry{op_code == Adc || op_code == Sbc || op_code == Rsc};
+
+		data_processing.variants[i_variant] = {
+			static_cast<std::uint8_t>(is_move ? 0b00 : 0b10),
+			static_cast<std::uint8_t>(is_comparison ? 0b00 : 0b01),
+			reads_carry ? cpsr_mask : 0U,
+			set_condition_codes || is_comparison ? cpsr_mask : 0U,
+		};
+	}
+
+	// Destination and source may be a status register
+	auto& move_from_psr{entry(MoveFromPsr)};
+	move_from_psr.registers = {{{16, 5}, {24, 5}, {}, {}}};
+	move_from_psr.variants[0] = {0b10, 0b01, 0, 0};
+
+	auto& move_to_psr{entry(MoveToPsr)};
+	move_to_psr.registers[0] = {16, 5};
+	move_to_psr.shift_operand_mask = ~0U;
+	move_to_psr.variants[0] = {0, 0b1, 0, 0};
+
+	// High destination, accumulator or low destination, first and second operands: variant is
+	// the set condition codes, accumulate and long bits
+	auto& multiply{entry(Multiply)};
+	multiply.registers = {{{16, 4}, {24, 4}, {32, 4}, {48, 4}}};
+	multiply.variant = {56, 3};
+	for (std::size_t i_variant{}; i_variant < 8; ++i_variant)
+	{
+		const auto set_condition_codes{(i_variant & 0b001U) != 0U};
+		const auto accumulate{(i_variant & 0b010U) != 0U};
+		const auto is_long{(i_variant & 0b100U) != 0U};
+
+		const auto accumulated{is_long ? 0b0011U : 0b0010U};
+		multiply.variants[i_variant] = {
+			static_cast<std::uint8_t>(0b1100U | (accumulate ? accumulated : 0U)),
+			static_cast<std::uint8_t>(is_long ? 0b0011U : 0b0001U),
+			0,
+			set_condition_codes ? cpsr_mask : 0U,
+		};
+	}
+
+	return table;
+}
+
+constexpr auto operation_accesses{make_operation_accesses()};
+
+// Every condition other than always reads the flags
+constexpr auto condition_reads{[]
+							   {
+								   std::array<std::uint32_t, 16> table{};
+								   table.fill(cpsr_mask);
+								   table[static_cast<std::size_t>(Condition::Al)] = 0;
+								   table[0xF] = 0;
+								   return table;
+							   }()};
+
+/*
+	Shift operand registers, selected by the operand type (bits 0-1) and the immediate shift type
+	(bits 6-8)
+*/
+struct OperandAccess
+{
+	std::uint8_t fields;
+	std::uint32_t reads;
+};
+
+constexpr std::array<Field, 3> operand_fields{{
+	{2, 4},	 // Immediate shifted source
+	{4, 4},	 // Register shifted source
+	{12, 4}, // Register shift amount
+}};
+
+constexpr auto operand_accesses{
+	[]
+	{
+		std::array<OperandAccess, 32> table{};
+		for (std::size_t i_shift_type{}; i_shift_type < 8; ++i_shift_type)
+		{
+			const auto is_extended{i_shift_type ==
+								   static_cast<std::size_t>(ShiftType::RotateRightExtended)};
+
+			// rrx shifts the carry in
+			table[(i_shift_type << 2U) | 2U] = {0b001, is_extended ? cpsr_mask : 0U};
+			table[(i_shift_type << 2U) | 3U] = {0b110, 0};
+		}
+		return table;
+	}()};
+
+[[nodiscard]] constexpr auto extract(const Unsigned<8> t_bits, const Field t_field) noexcept
+{
+	const BitRange range(BitIndex(t_field.offset), BitSize(t_field.size));
+	return static_cast<std::size_t>(get_bits<UbChecked::Unchecked>(t_bits, range).get());
+}
+
+// All bits set when bit t_index of t_fields is
+[[nodiscard]] constexpr auto select(const std::uint8_t t_fields, const std::size_t t_index) noexcept
+{
+	return 0U - ((static_cast<std::uint32_t>(t_fields) >> t_index) & 1U);
+}
+
+/*
+	Lookups
+*/
+export [[nodiscard]] constexpr auto def_use(const ins::Instruction t_instruction) noexcept
+{
+	const auto bits{t_instruction.to_underlying()};
+
+	const auto operation{std::min(extract(bits, {0, 8}), operation_count - 1)};
+	const auto& access{operation_accesses[operation]};
+	const auto& variant{access.variants[extract(bits, access.variant)]};
+
+	auto reads{variant.reads | condition_reads[extract(bits, {8, 4})]};
+	auto writes{variant.writes};
+	for (std::size_t i_field{}; i_field < max_register_fields; ++i_field)
+	{
+		const auto mask{1U << extract(bits, access.registers[i_field])};
+		reads |= select(variant.read_fields, i_field) & mask;
+		writes |= select(variant.write_fields, i_field) & mask;
+	}
+
+	const auto operand{Unsigned<8>(extract(bits, {32, 16}))};
+	const auto& operand_access{
+		operand_accesses[extract(operand, {0, 2}) | (extract(operand, {6, 3}) << 2U)]};
+
+	auto operand_reads{operand_access.reads};
+	for (std::size_t i_field{}; i_field < operand_fields.size(); ++i_field)
+	{
+		const auto mask{1U << extract(operand, operand_fields[i_field])};
+		operand_reads |= select(operand_access.fields, i_field) & mask;
+	}
+	reads |= operand_reads & access.shift_operand_mask;
+
+	return DefUse{reads, writes};
+}
+
+// t_results must hold at least as many elements as t_instructions
+export auto def_use(const std::span<const ins::Instruction> t_instructions,
+					const std::span<DefUse> t_results) -> void
+{
+	if (t_results.size() < t_instructions.size())
+	{
+		throw std::invalid_argument("Result span too small");
+	}
+
+	for (std::size_t i_instruction{}; i_instruction < t_instructions.size(); ++i_instruction)
+	{
+		t_results[i_instruction] = def_use(t_instructions[i_instruction]);
+	}
+}
+
+} // namespace dzl
+
+// NOLINTEND(*-magic-numbers)
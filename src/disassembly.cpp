@@ -0,0 +1,97 @@
+export module disassembly;
+
+import std;
+
+import unsigned_integer;
+import text_arena;
+
+import types;
+import instruction;
+import arm_instruction;
+import instruction_formatting;
+import data_classifier;
+
+namespace dzl
+{
+// Words that could not be decoded are emitted as data directives
+export auto format_decoded(const std::optional<ins::Instruction> t_instruction, const Word t_word,
+						   std::string& t_output) -> void
+{
+	if (!t_instruction)
+	{
+		std::format_to(std::back_inserter(t_output), ".word {:#010x}\n", t_word.get());
+		return;
+	}
+
+	std::format_to(std::back_inserter(t_output), "{}\n", *t_instruction);
+}
+
+// Same lines, appended to an arena instead of a growing string
+export auto format_decoded(const std::optional<ins::Instruction> t_instruction, const Word t_word,
+						   TextArena& t_output) -> std::string_view
+{
+	if (!t_instruction)
+	{
+		return t_output.format(".word {:#010x}\n", t_word.get());
+	}
+
+	return t_output.format("{}\n", *t_instruction);
+}
+
+export auto format_word(const Word t_word, std::string& t_output) -> void
+{
+	format_decoded(fmt::arm::try_decode(t_word), t_word, t_output);
+}
+
+/*
+	Decoding with a classification of the whole image, of which the words may be a slice, so that
+	the output does not depend on how an image is split up
+*/
+// Words classified as data are not decoded
+export [[nodiscard]] constexpr auto decode_classified(const Word t_word,
+													 const search::WordKind t_kind) noexcept
+	-> std::optional<ins::Instruction>
+{
+	return search::is_data(t_kind) ? std::nullopt : fmt::arm::try_decode(t_word);
+}
+
+// Reuses the capacity of t_instructions
+export auto decode_classified(const std::span<const Word> t_words,
+							  const std::span<const search::WordKind> t_kinds,
+							  std::vector<std::optional<ins::Instruction>>& t_instructions) -> void
+{
+	t_instructions.resize(t_words.size());
+	for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+	{
+		t_instructions[i_word] = decode_classified(t_words[i_word], t_kinds[i_word]);
+	}
+}
+
+// Classifies t_words as a whole image
+export [[nodiscard]] auto decode_classified(const std::span<const Word> t_words)
+	-> std::vector<std::optional<ins::Instruction>>
+{
+	std::vector<std::optional<ins::Instruction>> instructions;
+	decode_classified(t_words, search::classify(t_words), instructions);
+	return instructions;
+}
+
+// Appends one line per word, words classified as data are not decoded
+export auto disassemble(const std::span<const Word> t_words,
+						const std::span<const search::WordKind> t_kinds, std::string& t_output)
+	-> void
+{
+	for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+	{
+		format_decoded(decode_classified(t_words[i_word], t_kinds[i_word]), t_words[i_word],
+					   t_output);
+	}
+}
+
+// Classifies t_words as a whole image
+export auto disassemble(const std::span<const Word> t_words, std::string& t_output) -> void
+{
+	disassemble(t_words, search::classify(t_words), t_output);
+}
+
+} // namespace dzl
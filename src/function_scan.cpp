@@ -0,0 +1,151 @@
+export module function_scan;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import arm_instruction;
+import pattern_search;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::search
+{
+using fmt::arm::FormatMask;
+
+/*
+	Boundary encodings. Prologues and epilogues are only accepted unconditionally, conditional
+	ones being far more likely to be data.
+*/
+constexpr std::array boundary_masks{
+	// stmfd sp!, {..., lr}
+	FormatMask{.checked_bits = 0xFFFF'4000_u32, .required_bits = 0xE92D'4000_u32},
+	// str lr, [sp, #-4]!
+	FormatMask{.checked_bits = 0xFFFF'FFFF_u32, .required_bits = 0xE52D'E004_u32},
+	// bl, any condition
+	FormatMask{.checked_bits = 0x0F00'0000_u32, .required_bits = 0x0B00'0000_u32},
+
+	// ldmfd sp!, {..., pc}
+	FormatMask{.checked_bits = 0xFFFF'8000_u32, .required_bits = 0xE8BD'8000_u32},
+	// ldr pc, [sp], #4
+	FormatMask{.checked_bits = 0xFFFF'FFFF_u32, .required_bits = 0xE49D'F004_u32},
+	// bx lr
+	FormatMask{.checked_bits = 0xFFFF'FFFF_u32, .required_bits = 0xE12F'FF1E_u32},
+	// mov pc, lr
+	FormatMask{.checked_bits = 0xFFFF'FFFF_u32, .required_bits = 0xE1A0'F00E_u32}};
+
+constexpr std::size_t prologue_pattern_count{2};
+constexpr std::size_t call_pattern{2};
+
+export struct Function
+{
+	Address start;
+
+	// One past the first epilogue, or the start of the next function when there is none before it
+	Address end;
+
+	bool has_prologue;
+	bool is_call_target;
+};
+
+export [[nodiscard]] auto function_name(const Function& t_function)
+{
+	return std::format("sub_{:08x}", t_function.start.get());
+}
+
+// Index of the word a bl at t_index branches to, if inside the image
+[[nodiscard]] auto call_target(const std::span<const Word> t_words, const std::size_t t_index)
+	-> std::optional<std::size_t>
+{
+	// The never condition encodes blx
+	const auto instruction{fmt::arm::try_decode(t_words[t_index])};
+	if (!instruction || instruction->get_condition() == Condition(0xF))
+	{
+		return std::nullopt;
+	}
+
+	// Relative to the pc, two words ahead
+	const auto [operation, condition, link, offset]{instruction->get<ins::Branch>()};
+	const auto word_offset{static_cast<std::int32_t>(offset.get()) / 4};
+	const auto target{static_cast<std::int64_t>(t_index) + 2 + word_offset};
+
+	if (target < 0 || std::cmp_greater_equal(target, t_words.size()))
+	{
+		return std::nullopt;
+	}
+	return static_cast<std::size_t>(target);
+}
+
+/*
+	Function starts are prologues and call targets, sorted by address
+*/
+export [[nodiscard]] auto find_functions(const std::span<const Word> t_words, const Address t_base)
+{
+	struct Start
+	{
+		std::size_t index;
+		bool has_prologue;
+		bool is_call_target;
+	};
+
+	std::vector<Start> starts;
+	std::vector<std::size_t> epilogues;
+
+	for (const auto [index, pattern] : find_matches(t_words, boundary_masks))
+	{
+		if (pattern < prologue_pattern_count)
+		{
+			starts.push_back({index, true, false});
+		}
+		else if (pattern == call_pattern)
+		{
+			if (const auto target{call_target(t_words, index)})
+			{
+				starts.push_back({*target, false, true});
+			}
+		}
+		else
+		{
+			epilogues.push_back(index);
+		}
+	}
+
+	std::ranges::sort(starts, std::ranges::less(), &Start::index);
+
+	// Matches are reported in word order, so the epilogues are already sorted
+	const auto address_of{[&](const std::size_t t_index)
+						  {
+							  return Address(t_base.get() + static_cast<Address::Underlying>(
+																t_index * sizeof(Word)));
+						  }};
+
+	std::vector<Function> functions;
+	for (std::size_t i_start{}; i_start < starts.size();)
+	{
+		// Merge the reasons for the same start
+		auto start{starts[i_start]};
+		for (++i_start; i_start < starts.size() && starts[i_start].index == start.index; ++i_start)
+		{
+			start.has_prologue |= starts[i_start].has_prologue;
+			start.is_call_target |= starts[i_start].is_call_target;
+		}
+
+		const auto next_start{i_start < starts.size() ? starts[i_start].index : t_words.size()};
+		const auto epilogue{std::ranges::lower_bound(epilogues, start.index)};
+		const auto end{epilogue != epilogues.end() && *epilogue < next_start ? *epilogue + 1
+																			   : next_start};
+
+		functions.push_back({.start = address_of(start.index),
+							 .end = address_of(end),
+							 .has_prologue = start.has_prologue,
+							 .is_call_target = start.is_call_target});
+	}
+
+	return functions;
+}
+
+} // namespace dzl::search
+
+// NOLINTEND(*-magic-numbers)
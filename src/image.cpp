@@ -0,0 +1,125 @@
+module;
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+export module image;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::io
+{
+/*
+	Reverses the bytes of every word in place, 8 (AVX2) or 4 (SSSE3) words per shuffle
+*/
+auto swap_byte_order(const std::span<Word> t_words) noexcept -> void
+{
+	std::size_t i_word{};
+
+#if defined(__AVX2__)
+	const auto shuffle_256{_mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, //
+											3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)};
+	for (; i_word + 8 <= t_words.size(); i_word += 8)
+	{
+		auto* const data{reinterpret_cast<__m256i*>(t_words.data() + i_word)};
+		_mm256_storeu_si256(data, _mm256_shuffle_epi8(_mm256_loadu_si256(data), shuffle_256));
+	}
+#endif
+
+#if defined(__SSSE3__)
+	const auto shuffle_128{_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)};
+	for (; i_word + 4 <= t_words.size(); i_word += 4)
+	{
+		auto* const data{reinterpret_cast<__m128i*>(t_words.data() + i_word)};
+		_mm_storeu_si128(data, _mm_shuffle_epi8(_mm_loadu_si128(data), shuffle_128));
+	}
+#endif
+
+	for (; i_word < t_words.size(); ++i_word)
+	{
+		t_words[i_word] = Word(std::byteswap(t_words[i_word].get()));
+	}
+}
+
+// Converts words of the given byte order to the host byte order
+export auto to_native(const std::span<Word> t_words, const std::endian t_endianness) noexcept
+	-> void
+{
+	if (t_endianness != std::endian::native)
+	{
+		swap_byte_order(t_words);
+	}
+}
+
+// Index of the word at t_address in an image of t_word_count words from t_base, if inside it
+export [[nodiscard]] constexpr auto word_index(const Address t_base, const Address t_address,
+											   const std::size_t t_word_count) noexcept
+	-> std::optional<std::size_t>
+{
+	const auto offset{(t_address - t_base).get()};
+	if (offset % sizeof(Word) != 0 || offset / sizeof(Word) >= t_word_count)
+	{
+		return std::nullopt;
+	}
+	return offset / sizeof(Word);
+}
+
+export [[nodiscard]] auto image_word_count(const std::filesystem::path& t_path)
+{
+	return static_cast<std::size_t>(std::filesystem::file_size(t_path) / sizeof(Word));
+}
+
+// Words are read and converted in blocks small enough to still be cached when converted
+constexpr std::size_t read_block_word_count{16UZ * 1024UZ};
+
+/*
+	Loads instruction words of the given byte order from a raw image, optionally restricted to
+	a word range. Trailing bytes that do not form a complete word are ignored.
+*/
+export [[nodiscard]] auto load_image(const std::filesystem::path& t_path,
+									 const std::endian t_endianness = std::endian::little,
+									 const std::size_t t_first_word = 0,
+									 const std::optional<std::size_t> t_word_count = std::nullopt)
+{
+	const auto available_words{image_word_count(t_path)};
+	const auto first_word{std::min(t_first_word, available_words)};
+	const auto word_count{
+		std::min(t_word_count.value_or(available_words), available_words - first_word)};
+
+	std::ifstream file(t_path, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error(std::format("Cannot open {}", t_path.string()));
+	}
+
+	std::vector<Word> words(word_count);
+	file.seekg(static_cast<std::streamoff>(first_word * sizeof(Word)));
+
+	for (std::size_t i_word{}; i_word < word_count; i_word += read_block_word_count)
+	{
+		const auto block{std::span(words).subspan(
+			i_word, std::min(read_block_word_count, word_count - i_word))};
+
+		file.read(reinterpret_cast<char*>(block.data()),
+				  static_cast<std::streamsize>(block.size_bytes()));
+		if (!file)
+		{
+			throw std::runtime_error(std::format("Cannot read {}", t_path.string()));
+		}
+
+		to_native(block, t_endianness);
+	}
+
+	return words;
+}
+
+} // namespace dzl::io
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,438 @@
+export module image_diff;
+
+import std;
+
+import unsigned_integer;
+import hash;
+
+import types;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::diff
+{
+/*
+	A run of old words replaced by a run of new words, either run possibly empty
+*/
+export struct Change
+{
+	std::size_t old_begin;
+	std::size_t old_count;
+	std::size_t new_begin;
+	std::size_t new_count;
+
+	constexpr auto operator==(const Change&) const -> bool = default;
+};
+
+/*
+	Normalisation: pc-relative offsets are replaced by zero, so code that only moved compares equal
+*/
+export [[nodiscard]] constexpr auto normalize(const Word t_word) noexcept
+{
+	// b, bl
+	if ((t_word & 0x0E00'0000_u32) == 0x0A00'0000_u32)
+	{
+		return t_word & 0xFF00'0000_u32;
+	}
+
+	// ldr/ldrb rd, [pc, #+/-offset]
+	if ((t_word & 0x0F3F'0000_u32) == 0x051F'0000_u32)
+	{
+		return t_word & ~0x0080'0FFF_u32;
+	}
+
+	return t_word;
+}
+
+/*
+	Blocks end after control flow, or after max_block_word_count words
+*/
+constexpr std::size_t max_block_word_count{32};
+
+struct Block
+{
+	std::size_t begin;
+	std::uint64_t hash;
+};
+
+[[nodiscard]] constexpr auto ends_block(const Word t_word) noexcept
+{
+	const auto is_branch{(t_word & 0x0E00'0000_u32) == 0x0A00'0000_u32};
+	const auto is_branch_and_exchange{(t_word & 0x0FFF'FFF0_u32) == 0x012F'FF10_u32};
+	const auto is_pc_load_multiple{(t_word & 0x0E10'8000_u32) == 0x0810'8000_u32};
+	return is_branch || is_branch_and_exchange || is_pc_load_multiple;
+}
+
+[[nodiscard]] auto split_blocks(const std::span<const Word> t_normalized)
+{
+	std::vector<Block> blocks;
+
+	std::size_t begin{};
+	for (std::size_t i_word{}; i_word < t_normalized.size(); ++i_word)
+	{
+		const auto is_last{i_word + 1 == t_normalized.size()};
+		if (ends_block(t_normalized[i_word]) || i_word + 1 - begin == max_block_word_count ||
+			is_last)
+		{
+			const auto words{t_normalized.subspan(begin, i_word + 1 - begin)};
+			blocks.push_back({begin, xxhash64(std::as_bytes(words))});
+			begin = i_word + 1;
+		}
+	}
+
+	return blocks;
+}
+
+/*
+	Linear space Myers diff (middle snake bisection), producing the matched index pairs in
+	increasing order. Ranges needing more than max_edit_distance edits are left unmatched.
+*/
+using Matches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+constexpr std::ptrdiff_t max_edit_distance{1 << 12};
+
+// Point splitting the ranges into two independent halves
+template <typename Type>
+[[nodiscard]] auto bisect(const std::span<const Type> t_old, const std::span<const Type> t_new)
+	-> std::optional<std::pair<std::size_t, std::size_t>>
+{
+	const auto old_size{static_cast<std::ptrdiff_t>(t_old.size())};
+	const auto new_size{static_cast<std::ptrdiff_t>(t_new.size())};
+
+	const auto max_d{std::min((old_size + new_size + 1) / 2, max_edit_distance)};
+	const auto v_offset{max_d};
+	const auto v_length{(2 * max_d) + 2};
+
+	std::vector<std::ptrdiff_t> forward(static_cast<std::size_t>(v_length), -1);
+	std::vector<std::ptrdiff_t> backward(static_cast<std::size_t>(v_length), -1);
+	forward[static_cast<std::size_t>(v_offset + 1)] = 0;
+	backward[static_cast<std::size_t>(v_offset + 1)] = 0;
+
+	const auto at{[](std::vector<std::ptrdiff_t>& t_v, const std::ptrdiff_t t_index) -> auto&
+				  { return t_v[static_cast<std::size_t>(t_index)]; }};
+
+	const auto delta{old_size - new_size};
+	const auto front{delta % 2 != 0};
+
+	// Diagonals that ran off the edges are skipped
+	std::ptrdiff_t forward_start{};
+	std::ptrdiff_t forward_end{};
+	std::ptrdiff_t backward_start{};
+	std::ptrdiff_t backward_end{};
+
+	for (std::ptrdiff_t d{}; d < max_d; ++d)
+	{
+		for (auto k{-d + forward_start}; k <= d - forward_end; k += 2)
+		{
+			const auto k_offset{v_offset + k};
+			auto x{k == -d || (k != d && at(forward, k_offset - 1) < at(forward, k_offset + 1))
+					   ? at(forward, k_offset + 1)
+					   : at(forward, k_offset - 1) + 1};
+			auto y{x - k};
+			while (x < old_size && y < new_size &&
+				   t_old[static_cast<std::size_t>(x)] == t_new[static_cast<std::size_t>(y)])
+			{
+				++x;
+				++y;
+			}
+			at(forward, k_offset) = x;
+
+			if (x > old_size)
+			{
+				forward_end += 2;
+			}
+			else if (y > new_size)
+			{
+				forward_start += 2;
+			}
+			else if (front)
+			{
+				const auto backward_offset{v_offset + delta - k};
+				if (backward_offset >= 0 && backward_offset < v_length &&
+					at(backward, backward_offset) != -1 &&
+					x >= old_size - at(backward, backward_offset))
+				{
+					return std::pair{static_cast<std::size_t>(x), static_cast<std::size_t>(y)};
+				}
+			}
+		}
+
+		for (auto k{-d + backward_start}; k <= d - backward_end; k += 2)
+		{
+			const auto k_offset{v_offset + k};
+			auto x{k == -d || (k != d && at(backward, k_offset - 1) < at(backward, k_offset + 1))
+					   ? at(backward, k_offset + 1)
+					   : at(backward, k_offset - 1) + 1};
+			auto y{x - k};
+			while (x < old_size && y < new_size &&
+				   t_old[static_cast<std::size_t>(old_size - x - 1)] ==
+					   t_new[static_cast<std::size_t>(new_size - y - 1)])
+			{
+				++x;
+				++y;
+			}
+			at(backward, k_offset) = x;
+
+			if (x > old_size)
+			{
+				backward_end += 2;
+			}
+			else if (y > new_size)
+			{
+				backward_start += 2;
+			}
+			else if (!front)
+			{
+				const auto forward_offset{v_offset + delta - k};
+				if (forward_offset >= 0 && forward_offset < v_length &&
+					at(forward, forward_offset) != -1)
+				{
+					const auto forward_x{at(forward, forward_offset)};
+					const auto forward_y{v_offset + forward_x - forward_offset};
+					if (forward_x >= old_size - x)
+					{
+						return std::pair{static_cast<std::size_t>(forward_x),
+										 static_cast<std::size_t>(forward_y)};
+					}
+				}
+			}
+		}
+	}
+
+	return std::nullopt;
+}
+
+template <typename Type>
+auto match_sequences(std::span<const Type> t_old, std::span<const Type> t_new,
+					 std::size_t t_old_offset, std::size_t t_new_offset, Matches& t_matches)
+	-> void
+{
+	// Common prefix and suffix
+	std::size_t prefix{};
+	while (prefix < t_old.size() && prefix < t_new.size() && t_old[prefix] == t_new[prefix])
+	{
+		t_matches.emplace_back(t_old_offset + prefix, t_new_offset + prefix);
+		++prefix;
+	}
+	t_old = t_old.subspan(prefix);
+	t_new = t_new.subspan(prefix);
+	t_old_offset += prefix;
+	t_new_offset += prefix;
+
+	std::size_t suffix{};
+	while (suffix < t_old.size() && suffix < t_new.size() &&
+		   t_old[t_old.size() - 1 - suffix] == t_new[t_new.size() - 1 - suffix])
+	{
+		++suffix;
+	}
+	const auto old_middle{t_old.first(t_old.size() - suffix)};
+	const auto new_middle{t_new.first(t_new.size() - suffix)};
+
+	if (!old_middle.empty() && !new_middle.empty())
+	{
+		const auto split{bisect(old_middle, new_middle)};
+
+		// A split at either corner would not make progress
+		const auto is_corner{split && ((split->first == 0 && split->second == 0) ||
+									   (split->first == old_middle.size() &&
+										split->second == new_middle.size()))};
+		if (split && !is_corner)
+		{
+			const auto [old_split, new_split]{*split};
+			match_sequences(old_middle.first(old_split), new_middle.first(new_split),
+							t_old_offset, t_new_offset, t_matches);
+			match_sequences(old_middle.subspan(old_split), new_middle.subspan(new_split),
+							t_old_offset + old_split, t_new_offset + new_split, t_matches);
+		}
+	}
+
+	for (std::size_t i_suffix{}; i_suffix < suffix; ++i_suffix)
+	{
+		t_matches.emplace_back(t_old_offset + old_middle.size() + i_suffix,
+							   t_new_offset + new_middle.size() + i_suffix);
+	}
+}
+
+/*
+	Patience anchors: blocks occurring exactly once in each image, in increasing order in both
+*/
+[[nodiscard]] auto find_anchors(const std::span<const std::uint64_t> t_old,
+								const std::span<const std::uint64_t> t_new)
+{
+	struct Occurrences
+	{
+		std::size_t old_count;
+		std::size_t new_count;
+		std::size_t old_index;
+		std::size_t new_index;
+	};
+
+	std::unordered_map<std::uint64_t, Occurrences> occurrences;
+	occurrences.reserve(t_old.size());
+	for (std::size_t i_block{}; i_block < t_old.size(); ++i_block)
+	{
+		auto& entry{occurrences[t_old[i_block]]};
+		++entry.old_count;
+		entry.old_index = i_block;
+	}
+	for (std::size_t i_block{}; i_block < t_new.size(); ++i_block)
+	{
+		auto& entry{occurrences[t_new[i_block]]};
+		++entry.new_count;
+		entry.new_index = i_block;
+	}
+
+	Matches unique;
+	for (const auto& [hash, entry] : occurrences)
+	{
+		if (entry.old_count == 1 && entry.new_count == 1)
+		{
+			unique.emplace_back(entry.old_index, entry.new_index);
+		}
+	}
+	std::ranges::sort(unique);
+
+	// Longest increasing subsequence of the new indices, by patience sorting
+	std::vector<std::size_t> pile_tops;
+	std::vector<std::size_t> predecessors(unique.size());
+	for (std::size_t i_unique{}; i_unique < unique.size(); ++i_unique)
+	{
+		const auto pile{std::ranges::lower_bound(pile_tops, unique[i_unique].second, std::ranges::less(),
+												 [&](const std::size_t t_top)
+												 { return unique[t_top].second; })};
+		predecessors[i_unique] =
+			pile == pile_tops.begin() ? unique.size() : *std::ranges::prev(pile);
+
+		if (pile == pile_tops.end())
+		{
+			pile_tops.push_back(i_unique);
+		}
+		else
+		{
+			*pile = i_unique;
+		}
+	}
+
+	Matches anchors;
+	for (auto i_unique{pile_tops.empty() ? unique.size() : pile_tops.back()};
+		 i_unique != unique.size(); i_unique = predecessors[i_unique])
+	{
+		anchors.push_back(unique[i_unique]);
+	}
+	std::ranges::reverse(anchors);
+
+	return anchors;
+}
+
+// Calls t_emit with every unmatched gap between the matches of two sequences
+auto for_each_gap(const Matches& t_matches, const std::size_t t_old_size,
+				  const std::size_t t_new_size, const std::invocable<Change> auto& t_emit) -> void
+{
+	std::size_t old_position{};
+	std::size_t new_position{};
+
+	const auto emit_until{[&](const std::size_t t_old_end, const std::size_t t_new_end)
+						  {
+							  if (t_old_end != old_position || t_new_end != new_position)
+							  {
+								  t_emit(Change{old_position, t_old_end - old_position,
+												new_position, t_new_end - new_position});
+							  }
+						  }};
+
+	for (const auto [old_index, new_index] : t_matches)
+	{
+		emit_until(old_index, new_index);
+		old_position = old_index + 1;
+		new_position = new_index + 1;
+	}
+	emit_until(t_old_size, t_new_size);
+}
+
+/*
+	Block changes are refined word by word up to this size
+*/
+constexpr std::size_t max_refined_word_count{1 << 16};
+
+export [[nodiscard]] auto diff(const std::span<const Word> t_old, const std::span<const Word> t_new)
+{
+	std::vector<Word> old_normalized(t_old.size());
+	std::vector<Word> new_normalized(t_new.size());
+	std::ranges::transform(t_old, old_normalized.begin(), normalize);
+	std::ranges::transform(t_new, new_normalized.begin(), normalize);
+
+	const auto old_blocks{split_blocks(old_normalized)};
+	const auto new_blocks{split_blocks(new_normalized)};
+
+	std::vector<std::uint64_t> old_hashes(old_blocks.size());
+	std::vector<std::uint64_t> new_hashes(new_blocks.size());
+	std::ranges::transform(old_blocks, old_hashes.begin(), &Block::hash);
+	std::ranges::transform(new_blocks, new_hashes.begin(), &Block::hash);
+
+	// Myers between consecutive anchors
+	Matches block_matches;
+	std::pair<std::size_t, std::size_t> previous{};
+	const auto match_until{
+		[&](const std::size_t t_old_end, const std::size_t t_new_end)
+		{
+			match_sequences(std::span<const std::uint64_t>(old_hashes).subspan(
+								previous.first, t_old_end - previous.first),
+							std::span<const std::uint64_t>(new_hashes)
+								.subspan(previous.second, t_new_end - previous.second),
+							previous.first, previous.second, block_matches);
+		}};
+
+	for (const auto anchor : find_anchors(old_hashes, new_hashes))
+	{
+		match_until(anchor.first, anchor.second);
+		block_matches.push_back(anchor);
+		previous = {anchor.first + 1, anchor.second + 1};
+	}
+	match_until(old_hashes.size(), new_hashes.size());
+
+	// Block gaps to word changes, refined where small enough
+	const auto word_index{[](const std::span<const Block> t_blocks, const std::size_t t_block,
+							 const std::size_t t_word_count)
+						  { return t_block < t_blocks.size() ? t_blocks[t_block].begin : t_word_count; }};
+
+	std::vector<Change> changes;
+	for_each_gap(
+		block_matches, old_blocks.size(), new_blocks.size(),
+		[&](const Change& t_block_change)
+		{
+			const auto old_begin{word_index(old_blocks, t_block_change.old_begin, t_old.size())};
+			const auto old_end{word_index(
+				old_blocks, t_block_change.old_begin + t_block_change.old_count, t_old.size())};
+			const auto new_begin{word_index(new_blocks, t_block_change.new_begin, t_new.size())};
+			const auto new_end{word_index(
+				new_blocks, t_block_change.new_begin + t_block_change.new_count, t_new.size())};
+
+			const auto old_count{old_end - old_begin};
+			const auto new_count{new_end - new_begin};
+			if (old_count == 0 || new_count == 0 || old_count > max_refined_word_count ||
+				new_count > max_refined_word_count)
+			{
+				changes.push_back({old_begin, old_count, new_begin, new_count});
+				return;
+			}
+
+			Matches word_matches;
+			match_sequences(std::span<const Word>(old_normalized).subspan(old_begin, old_count),
+							std::span<const Word>(new_normalized).subspan(new_begin, new_count),
+							0, 0, word_matches);
+			for_each_gap(word_matches, old_count, new_count,
+						 [&](const Change& t_word_change)
+						 {
+							 changes.push_back({old_begin + t_word_change.old_begin,
+												t_word_change.old_count,
+												new_begin + t_word_change.new_begin,
+												t_word_change.new_count});
+						 });
+		});
+
+	return changes;
+}
+
+} // namespace dzl::diff
+
+// NOLINTEND(*-magic-numbers)
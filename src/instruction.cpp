@@ -160,6 +160,8 @@ public:
 		return Type(m_underlying);
 	}
 
+	[[nodiscard]] constexpr auto to_underlying() const noexcept { return m_underlying; }
+
 private:
 	InstructionBits m_underlying;
 };
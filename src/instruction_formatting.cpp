@@ -6,163 +6,256 @@ import unsigned_integer;
 import types;
 import shift_operand;
 import instruction;
+import mnemonic_tables;
+
+/*
+	Composite formatters write straight into the output, without an intermediate string per
+	operand or line. A format specification such as a width is still honoured: only then is the
+	text formatted into a stack buffer first and padded like a string.
+*/
+template <typename Value> struct DirectFormatter : std::formatter<std::string_view>
+{
+	constexpr auto parse(std::format_parse_context& t_context)
+	{
+		m_padded = t_context.begin() != t_context.end() && *t_context.begin() != '}';
+		return std::formatter<std::string_view>::parse(t_context);
+	}
+
+	[[nodiscard]] auto format(const Value t_value, std::format_context& t_context) const
+	{
+		if (!m_padded)
+		{
+			return static_cast<const std::formatter<Value>&>(*this).write(t_value, t_context);
+		}
+
+		// Longer than any line, longer text still formats through a string
+		std::array<char, 128> buffer;
+		const auto [end, size]{std::format_to_n(buffer.data(), buffer.size(), "{}", t_value)};
+		if (std::cmp_less_equal(size, buffer.size()))
+		{
+			return std::formatter<std::string_view>::format(
+				std::string_view(buffer.data(), end), t_context);
+		}
+		return std::formatter<std::string_view>::format(std::format("{}", t_value), t_context);
+	}
+
+private:
+	bool m_padded{};
+};
 
 // Condition
-template <> struct std::formatter<dzl::Condition> : std::formatter<std::string>
+template <> struct std::formatter<dzl::Condition> : std::formatter<std::string_view>
 {
 	[[nodiscard]] constexpr auto format(const dzl::Condition t_condition,
 										std::format_context& t_context) const
 	{
-		constexpr static std::array names{"eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc",
-										  "hi", "ls", "ge", "lt", "gt", "le", ""};
-
-		const auto index{static_cast<std::size_t>(t_condition)};
-		const auto formatted{std::format("{}", names.at(index))};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::formatter<std::string_view>::format(dzl::mnemonic::condition_name(t_condition),
+														t_context);
 	}
 };
 
 // Register
-template <> struct std::formatter<dzl::Register> : std::formatter<std::string>
+template <> struct std::formatter<dzl::Register> : std::formatter<std::string_view>
 {
 	[[nodiscard]] constexpr auto format(const dzl::Register t_register,
 										std::format_context& t_context) const
 	{
-		constexpr static std::array names{"r0",	 "r1", "r2", "r3", "r4",   "r5",
-										  "r6",	 "r7", "r8", "r9", "r10",  "r11",
-										  "r12", "sp", "lr", "pc", "cpsr", "spsr"};
+		constexpr static std::array<std::string_view, 18> names{
+			"r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11", "r12",
+			"sp", "lr", "pc", "cpsr", "spsr"};
 
 		const auto index{static_cast<std::size_t>(t_register)};
-		const auto formatted{std::format("{}", names.at(index))};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::formatter<std::string_view>::format(names.at(index), t_context);
 	}
 };
 
 // ShiftType
-template <> struct std::formatter<dzl::ShiftType> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ShiftType> : std::formatter<std::string_view>
 {
 	[[nodiscard]] constexpr auto format(const dzl::ShiftType t_shift_type,
 										std::format_context& t_context) const
 	{
-		constexpr static std::array names{"lsl", "lsr", "asr", "ror", "rrx"};
+		constexpr static std::array<std::string_view, 5> names{"lsl", "lsr", "asr", "ror", "rrx"};
 
 		const auto index{static_cast<std::size_t>(t_shift_type)};
-		const auto formatted{std::format("{}", names.at(index))};
+		return std::formatter<std::string_view>::format(names.at(index), t_context);
+	}
+};
+
+namespace dzl
+{
+/*
+	Text of every ShiftOperand bit pattern, built on first use rather than at compile time, where
+	65536 entries exceed Clang's constant evaluation step limit
+*/
+// Longest texts are "r10, lsl #31" and "#0xff000000"
+constexpr std::size_t max_shift_operand_size{15};
+constexpr std::size_t shift_operand_count{1UZ << 16U};
+
+struct ShiftOperandText
+{
+	std::array<char, max_shift_operand_size> text;
+	std::uint8_t size;
 
-		return std::formatter<std::string>::format(formatted, t_context);
+	[[nodiscard]] constexpr auto view() const noexcept
+	{
+		return std::string_view(text.data(), size);
 	}
 };
 
-// ShiftOperand
-template <> struct std::formatter<dzl::ShiftOperand> : std::formatter<std::string>
+template <std::output_iterator<char> Output>
+auto render_shift_operand(const ShiftOperand t_shift_operand, Output t_output) -> Output
 {
-	[[nodiscard]] constexpr auto format(const dzl::ShiftOperand t_shift_operand,
-										std::format_context& t_context) const
+	switch (t_shift_operand.get_type())
 	{
-		switch (t_shift_operand.get_type())
-		{
-		case dzl::ShiftOperandType::Immediate:
-		{
-			const auto [type, value]{t_shift_operand.get<dzl::ImmediateOperand>()};
+	case ShiftOperandType::Immediate:
+	{
+		const auto [type, value]{t_shift_operand.get<ImmediateOperand>()};
 
-			const auto formatted{std::format("#{:#x}", value.get())};
-			return std::formatter<std::string>::format(formatted, t_context);
-		}
-		case dzl::ShiftOperandType::RotatedImmediate:
-		{
-			const auto [type, source, amount]{t_shift_operand.get<dzl::RotatedImmediateOperand>()};
+		return std::format_to(t_output, "#{:#x}", value.get());
+	}
+	case ShiftOperandType::RotatedImmediate:
+	{
+		const auto [type, source, amount]{t_shift_operand.get<RotatedImmediateOperand>()};
 
-			const dzl::Word extended_source(source.get());
-			const auto rotate_result{rotate_right(extended_source, amount)};
+		const Word extended_source(source.get());
+		const auto rotate_result{rotate_right(extended_source, amount)};
 
-			const auto formatted{std::format("#{:#x}", rotate_result.get())};
-			return std::formatter<std::string>::format(formatted, t_context);
-		}
-		case dzl::ShiftOperandType::ImmediateShiftedRegister:
+		return std::format_to(t_output, "#{:#x}", rotate_result.get());
+	}
+	case ShiftOperandType::ImmediateShiftedRegister:
+	{
+		const auto [type, source, shift_type,
+					amount]{t_shift_operand.get<ImmediateShiftedRegisterOperand>()};
+
+		// Rotate right extended
+		if (shift_type == ShiftType::RotateRightExtended)
 		{
-			const auto [type, source, shift_type,
-						amount]{t_shift_operand.get<dzl::ImmediateShiftedRegisterOperand>()};
-
-			// Rotate right extended
-			if (shift_type == dzl::ShiftType::RotateRightExtended)
-			{
-				const auto formatted{
-					std::format("{}, {}", source, dzl::ShiftType::RotateRightExtended)};
-				return std::formatter<std::string>::format(formatted, t_context);
-			}
-
-			// Unshifted register
-			if (amount == 0_sh)
-			{
-				const auto formatted{std::format("{}", source)};
-				return std::formatter<std::string>::format(formatted, t_context);
-			}
-
-			const auto formatted{std::format("{}, {} #{}", source, shift_type, amount.get())};
-			return std::formatter<std::string>::format(formatted, t_context);
+			return std::format_to(t_output, "{}, {}", source, ShiftType::RotateRightExtended);
 		}
-		case dzl::ShiftOperandType::RegisterShiftedRegister:
+
+		// Unshifted register
+		if (amount == 0_sh)
 		{
-			const auto [type, source, shift_type,
-						amount]{t_shift_operand.get<dzl::RegisterShiftedRegisterOperand>()};
+			return std::format_to(t_output, "{}", source);
+		}
 
-			const auto formatted{std::format("{}, {} {}", source, shift_type, amount)};
-			return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_output, "{}, {} #{}", source, shift_type, amount.get());
+	}
+	case ShiftOperandType::RegisterShiftedRegister:
+	{
+		const auto [type, source, shift_type,
+					amount]{t_shift_operand.get<RegisterShiftedRegisterOperand>()};
+
+		return std::format_to(t_output, "{}, {} {}", source, shift_type, amount);
+	}
+	default:
+		std::unreachable();
+	}
+}
+
+// Shift types past rrx are never decoded and get no text
+[[nodiscard]] constexpr auto has_text(const ShiftOperand t_shift_operand) noexcept
+{
+	if (t_shift_operand.get_type() != ShiftOperandType::ImmediateShiftedRegister)
+	{
+		return true;
+	}
+
+	const auto [type, source, shift_type,
+				amount]{t_shift_operand.get<ImmediateShiftedRegisterOperand>()};
+	return shift_type <= ShiftType::RotateRightExtended;
+}
+
+[[nodiscard]] auto make_shift_operand_texts()
+{
+	std::vector<ShiftOperandText> texts(shift_operand_count);
+	std::array<char, 2 * max_shift_operand_size> buffer{};
+
+	for (std::size_t i_bits{}; i_bits < shift_operand_count; ++i_bits)
+	{
+		const ShiftOperand shift_operand(Unsigned<2>(static_cast<std::uint16_t>(i_bits)));
+		if (!has_text(shift_operand))
+		{
+			continue;
 		}
-		default:
-			std::unreachable();
+
+		const auto end{render_shift_operand(shift_operand, buffer.data())};
+		const auto size{static_cast<std::size_t>(end - buffer.data())};
+		if (size > max_shift_operand_size)
+		{
+			throw std::length_error("Shift operand text too long");
 		}
+
+		std::ranges::copy_n(buffer.data(), static_cast<std::ptrdiff_t>(size),
+							texts[i_bits].text.begin());
+		texts[i_bits].size = static_cast<std::uint8_t>(size);
+	}
+
+	return texts;
+}
+
+[[nodiscard]] auto shift_operand_text(const ShiftOperand t_shift_operand) -> std::string_view
+{
+	static const auto texts{make_shift_operand_texts()};
+	return texts[t_shift_operand.to_underlying().get()].view();
+}
+
+} // namespace dzl
+
+// ShiftOperand
+template <> struct std::formatter<dzl::ShiftOperand> : DirectFormatter<dzl::ShiftOperand>
+{
+	[[nodiscard]] auto write(const dzl::ShiftOperand t_shift_operand,
+							 std::format_context& t_context) const
+	{
+		return std::ranges::copy(dzl::shift_operand_text(t_shift_operand), t_context.out()).out;
 	}
 };
 
 // Branch and exchange
-template <> struct std::formatter<dzl::ins::BranchAndExchange> : std::formatter<std::string>
+template <>
+struct std::formatter<dzl::ins::BranchAndExchange> : DirectFormatter<dzl::ins::BranchAndExchange>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::BranchAndExchange t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::BranchAndExchange t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, destination]{t_instruction};
 
-		const auto formatted{std::format("bx{} {}",	 //
-										 condition,	 // Condition
-										 destination // Destination
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {}",						  //
+							  dzl::mnemonic::branch_and_exchange(condition), // Mnemonic
+							  destination									  // Destination
+		);
 	}
 };
 
 // Branch
-template <> struct std::formatter<dzl::ins::Branch> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ins::Branch> : DirectFormatter<dzl::ins::Branch>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::Branch t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::Branch t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, link, offset]{t_instruction};
 
-		const auto formatted{std::format("b{}{} {:#x}",					//
-										 condition,						// Condition
-										 link ? 'l' : '\0',				// Link
-										 static_cast<int>(offset.get()) // Offset
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {:#x}",				   //
+							  dzl::mnemonic::branch(link, condition), // Mnemonic
+							  static_cast<int>(offset.get())		   // Offset
+		);
 	}
 };
 
 // Data processing
-template <> struct std::formatter<dzl::ins::DataProcessing> : std::formatter<std::string>
+template <>
+struct std::formatter<dzl::ins::DataProcessing> : DirectFormatter<dzl::ins::DataProcessing>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::DataProcessing t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::DataProcessing t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, op_code, set_condition_codes, destination, first,
 					second]{t_instruction};
 
-		constexpr static std::array names{"and", "eor", "sub", "rsb", "add", "adc", "sbc", "rsc",
-										  "tst", "teq", "cmp", "cmn", "orr", "mov", "bic", "mvn"};
+		const auto mnemonic{
+			dzl::mnemonic::data_processing(op_code, condition, set_condition_codes)};
 
 		if (op_code == dzl::ins::DataProcessingOpCode::Tst ||
 			op_code == dzl::ins::DataProcessingOpCode::Teq ||
@@ -170,166 +263,134 @@ template <> struct std::formatter<dzl::ins::DataProcessing> : std::formatter<std
 			op_code == dzl::ins::DataProcessingOpCode::Cmn)
 		{
 			// No destination
-			const auto formatted{std::format("{}{} {}, {}",							   //
-											 names[static_cast<std::size_t>(op_code)], // Op code
-											 condition,								   // Condition
-											 first,									   // First
-											 second									   // Second
-											 )};
-
-			return std::formatter<std::string>::format(formatted, t_context);
+			return std::format_to(t_context.out(), "{} {}, {}", //
+								  mnemonic,						// Mnemonic
+								  first,						// First
+								  second						// Second
+			);
 		}
 
 		if (op_code == dzl::ins::DataProcessingOpCode::Mov ||
 			op_code == dzl::ins::DataProcessingOpCode::Mvn)
 		{
 			// No first operand
-			const auto formatted{
-				std::format("{}{}{} {}, {}",						  //
-							names[static_cast<std::size_t>(op_code)], // Op code
-							condition,								  // Condition
-							set_condition_codes ? 's' : '\0',		  // Set condition codes
-							destination,							  // Destination
-							second									  // Second
-							)};
-
-			return std::formatter<std::string>::format(formatted, t_context);
+			return std::format_to(t_context.out(), "{} {}, {}", //
+								  mnemonic,						// Mnemonic
+								  destination,					// Destination
+								  second						// Second
+			);
 		}
 
-		const auto formatted{std::format("{}{}{} {}, {}, {}",					   //
-										 names[static_cast<std::size_t>(op_code)], // Op code
-										 condition,								   // Condition
-										 set_condition_codes ? 's' : '\0', // Set condition codes
-										 destination,					   // Destination
-										 first,							   // First
-										 second							   // Second
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {}, {}, {}", //
+							  mnemonic,							// Mnemonic
+							  destination,						// Destination
+							  first,							// First
+							  second							// Second
+		);
 	}
 };
 
 // Move from PSR
-template <> struct std::formatter<dzl::ins::MoveFromPsr> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ins::MoveFromPsr> : DirectFormatter<dzl::ins::MoveFromPsr>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::MoveFromPsr t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::MoveFromPsr t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, destination, first]{t_instruction};
 
-		const auto formatted{std::format("mrs{} {}, {}", //
-										 condition,		 // Condition
-										 destination,	 // Destination
-										 first			 // Source
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {}, {}",			 //
+							  dzl::mnemonic::move_from_psr(condition), // Mnemonic
+							  destination,							 // Destination
+							  first									 // Source
+		);
 	}
 };
 
 // Move to PSR
-template <> struct std::formatter<dzl::ins::MoveToPsr> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ins::MoveToPsr> : DirectFormatter<dzl::ins::MoveToPsr>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::MoveToPsr t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::MoveToPsr t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, destination, source, flags_only]{t_instruction};
 
-		const auto formatted{std::format("msr{} {}{}, {}",		   //
-										 condition,				   // Condition
-										 destination,			   // Destination
-										 flags_only ? "_flg" : "", // Flags suffix
-										 source					   // Source
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {}{}, {}",		   //
+							  dzl::mnemonic::move_to_psr(condition), // Mnemonic
+							  destination,							   // Destination
+							  flags_only ? "_flg" : "",				   // Flags suffix
+							  source								   // Source
+		);
 	}
 };
 
 // Multiply
-template <> struct std::formatter<dzl::ins::Multiply> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ins::Multiply> : DirectFormatter<dzl::ins::Multiply>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::Multiply t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::Multiply t_instruction,
+									   std::format_context& t_context) const
 	{
 		const auto [operation, condition, destination, accumulator, first, second,
 					set_condition_codes, accumulate, is_long, is_unsigned]{t_instruction};
 
+		const auto mnemonic{dzl::mnemonic::multiply(is_long, is_unsigned, accumulate, condition,
+													set_condition_codes)};
+
 		if (is_long)
 		{
-			const auto formatted{
-				std::format("{}{}{}{} {}, {}, {}, {}",		  //
-							is_unsigned ? 'u' : 's',		  // Unsigned
-							accumulate ? "mlal" : "mull",	  // Op code (accumulate)
-							condition,						  // Condition
-							set_condition_codes ? 's' : '\0', // Set condition codes
-							destination,					  // Destination (high bytes)
-							accumulator,					  // Destination (low bytes)
-							first,							  // First
-							second							  // Second
-							)};
-
-			return std::formatter<std::string>::format(formatted, t_context);
+			return std::format_to(t_context.out(), "{} {}, {}, {}, {}", //
+								  mnemonic,								// Mnemonic
+								  destination,							// Destination (high bytes)
+								  accumulator,							// Destination (low bytes)
+								  first,								// First
+								  second								// Second
+			);
 		}
 
 		if (accumulate)
 		{
-			const auto formatted{
-				std::format("mla{}{} {}, {}, {}, {}",		  //
-							condition,						  // Condition
-							set_condition_codes ? 's' : '\0', // Set condition codes
-							destination,					  // Destination
-							first,							  // First
-							second,							  // Second
-							accumulator						  // Accumulator
-							)};
-
-			return std::formatter<std::string>::format(formatted, t_context);
+			return std::format_to(t_context.out(), "{} {}, {}, {}, {}", //
+								  mnemonic,								// Mnemonic
+								  destination,							// Destination
+								  first,								// First
+								  second,								// Second
+								  accumulator							// Accumulator
+			);
 		}
 
-		const auto formatted{std::format("mul{}{} {}, {}, {}",			   //
-										 condition,						   // Condition
-										 set_condition_codes ? 's' : '\0', // Set condition codes
-										 destination,					   // Destination
-										 first,							   // First
-										 second							   // Second
-										 )};
-
-		return std::formatter<std::string>::format(formatted, t_context);
+		return std::format_to(t_context.out(), "{} {}, {}, {}", //
+							  mnemonic,							// Mnemonic
+							  destination,						// Destination
+							  first,							// First
+							  second							// Second
+		);
 	}
 };
 
 // Instruction
-template <> struct std::formatter<dzl::ins::Instruction> : std::formatter<std::string>
+template <> struct std::formatter<dzl::ins::Instruction> : DirectFormatter<dzl::ins::Instruction>
 {
-	[[nodiscard]] constexpr auto format(const dzl::ins::Instruction t_instruction,
-										std::format_context& t_context) const
+	[[nodiscard]] constexpr auto write(const dzl::ins::Instruction t_instruction,
+									   std::format_context& t_context) const
 	{
 		switch (t_instruction.get_operation())
 		{
 		case dzl::ins::Operation::BranchAndExchange:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::BranchAndExchange>()), t_context);
+			return format_as<dzl::ins::BranchAndExchange>(t_instruction, t_context);
 
 		case dzl::ins::Operation::Branch:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::Branch>()), t_context);
+			return format_as<dzl::ins::Branch>(t_instruction, t_context);
 
 		case dzl::ins::Operation::DataProcessing:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::DataProcessing>()), t_context);
+			return format_as<dzl::ins::DataProcessing>(t_instruction, t_context);
 
 		case dzl::ins::Operation::MoveFromPsr:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::MoveFromPsr>()), t_context);
+			return format_as<dzl::ins::MoveFromPsr>(t_instruction, t_context);
 
 		case dzl::ins::Operation::MoveToPsr:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::MoveToPsr>()), t_context);
+			return format_as<dzl::ins::MoveToPsr>(t_instruction, t_context);
 
 		case dzl::ins::Operation::Multiply:
-			return std::formatter<std::string>::format(
-				std::format("{}", t_instruction.get<dzl::ins::Multiply>()), t_context);
+			return format_as<dzl::ins::Multiply>(t_instruction, t_context);
 
 		case dzl::ins::Operation::Load:
 		case dzl::ins::Operation::Store:
@@ -348,4 +409,13 @@ template <> struct std::formatter<dzl::ins::Instruction> : std::formatter<std::s
 			std::unreachable();
 		}
 	}
+
+private:
+	// Formats into the same context rather than through a nested std::format_to
+	template <typename Type>
+	[[nodiscard]] constexpr static auto format_as(const dzl::ins::Instruction t_instruction,
+												  std::format_context& t_context)
+	{
+		return std::formatter<Type>{}.write(t_instruction.get<Type>(), t_context);
+	}
 };
\ No newline at end of file
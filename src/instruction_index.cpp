@@ -0,0 +1,452 @@
+export module instruction_index;
+
+import std;
+
+import unsigned_integer;
+import mapped_file;
+
+import types;
+import shift_operand;
+import instruction;
+import arm_instruction;
+import def_use;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::index
+{
+export enum struct KeyKind : Unsigned<1>::Underlying{Operation, OpCode,	 Condition,
+													 Reads,		Writes, Immediate};
+
+export using Key = std::uint64_t;
+
+export [[nodiscard]] constexpr auto make_key(const KeyKind t_kind, const std::uint32_t t_value) noexcept
+{
+	return (static_cast<Key>(t_kind) << 32U) | t_value;
+}
+
+/*
+	Key extraction
+*/
+// The value of an immediate second operand, after rotation
+[[nodiscard]] constexpr auto immediate_value(const ShiftOperand t_operand) noexcept
+	-> std::optional<std::uint32_t>
+{
+	switch (t_operand.get_type())
+	{
+	case ShiftOperandType::Immediate:
+	{
+		const auto [type, value]{t_operand.get<ImmediateOperand>()};
+		return value.get();
+	}
+	case ShiftOperandType::RotatedImmediate:
+	{
+		const auto [type, source, amount]{t_operand.get<RotatedImmediateOperand>()};
+		return rotate_right(Word(source.get()), amount).get();
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+auto for_each_key(const ins::Instruction t_instruction, const std::invocable<Key> auto& t_callback)
+	-> void
+{
+	const auto operation{t_instruction.get_operation()};
+	t_callback(make_key(KeyKind::Operation, static_cast<std::uint32_t>(operation)));
+	t_callback(make_key(KeyKind::Condition,
+						static_cast<std::uint32_t>(t_instruction.get_condition())));
+
+	const auto [reads, writes]{def_use(t_instruction)};
+	for (auto remaining{reads}; remaining != 0U; remaining &= remaining - 1U)
+	{
+		t_callback(make_key(KeyKind::Reads, static_cast<std::uint32_t>(std::countr_zero(remaining))));
+	}
+	for (auto remaining{writes}; remaining != 0U; remaining &= remaining - 1U)
+	{
+		t_callback(make_key(KeyKind::Writes, static_cast<std::uint32_t>(std::countr_zero(remaining))));
+	}
+
+	std::optional<ShiftOperand> second;
+	if (operation == ins::Operation::DataProcessing)
+	{
+		const auto [encoded_operation, condition, op_code, set_condition_codes, destination,
+					first, operand]{t_instruction.get<ins::DataProcessing>()};
+		t_callback(make_key(KeyKind::OpCode, static_cast<std::uint32_t>(op_code)));
+		second = operand;
+	}
+	else if (operation == ins::Operation::MoveToPsr)
+	{
+		const auto [encoded_operation, condition, destination, source, flags_only]{
+			t_instruction.get<ins::MoveToPsr>()};
+		second = source;
+	}
+
+	if (second)
+	{
+		if (const auto immediate{immediate_value(*second)})
+		{
+			t_callback(make_key(KeyKind::Immediate, *immediate));
+		}
+	}
+}
+
+/*
+	File layout (host byte order):
+
+	header
+	key entries, sorted by key
+	postings: per key, the word indices as LEB128 encoded deltas
+*/
+struct FileHeader
+{
+	std::array<char, 8> magic;
+	std::uint32_t version;
+	std::uint32_t base_address;
+	std::uint64_t word_count;
+	std::uint64_t key_count;
+};
+
+struct KeyEntry
+{
+	Key key;
+	std::uint64_t offset;
+	std::uint64_t count;
+};
+
+constexpr std::array<char, 8> file_magic{'D', 'Z', 'L', 'I', 'N', 'D', 'E', 'X'};
+constexpr std::uint32_t file_version{1};
+
+auto encode_postings(const std::span<const std::uint32_t> t_indices,
+					 std::vector<std::byte>& t_output) -> void
+{
+	std::uint32_t previous{};
+	for (const auto index : t_indices)
+	{
+		auto delta{index - previous};
+		previous = index;
+
+		do
+		{
+			auto byte{static_cast<std::uint8_t>(delta & 0x7FU)};
+			delta >>= 7U;
+			if (delta != 0U)
+			{
+				byte |= 0x80U;
+			}
+			t_output.push_back(static_cast<std::byte>(byte));
+		} while (delta != 0U);
+	}
+}
+
+[[nodiscard]] auto decode_postings(std::span<const std::byte> t_bytes, const std::size_t t_count)
+{
+	std::vector<std::uint32_t> indices;
+	indices.reserve(t_count);
+
+	std::uint32_t previous{};
+	for (std::size_t i_index{}; i_index < t_count; ++i_index)
+	{
+		std::uint32_t delta{};
+		for (unsigned shift{};; shift += 7U)
+		{
+			if (t_bytes.empty() || shift >= 32U)
+			{
+				throw std::runtime_error("Corrupt posting list");
+			}
+
+			const auto byte{static_cast<std::uint32_t>(t_bytes.front())};
+			t_bytes = t_bytes.subspan(1);
+
+			delta |= (byte & 0x7FU) << shift;
+			if ((byte & 0x80U) == 0U)
+			{
+				break;
+			}
+		}
+
+		previous += delta;
+		indices.push_back(previous);
+	}
+
+	return indices;
+}
+
+template <typename Type>
+[[nodiscard]] auto read_struct(const std::span<const std::byte> t_bytes, const std::size_t t_offset)
+{
+	if (t_offset + sizeof(Type) > t_bytes.size())
+	{
+		throw std::runtime_error("Truncated index");
+	}
+
+	Type value;
+	std::memcpy(&value, t_bytes.data() + t_offset, sizeof(Type));
+	return value;
+}
+
+template <typename Type> auto write_struct(std::ostream& t_stream, const Type& t_value) -> void
+{
+	t_stream.write(reinterpret_cast<const char*>(&t_value), sizeof(Type));
+}
+
+export auto build_index(const std::span<const Word> t_words, const Address t_base,
+						const std::filesystem::path& t_path) -> void
+{
+	std::map<Key, std::vector<std::uint32_t>> postings;
+
+	for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+	{
+		const auto instruction{fmt::arm::try_decode(t_words[i_word])};
+		if (!instruction)
+		{
+			continue;
+		}
+
+		const auto index{static_cast<std::uint32_t>(i_word)};
+		for_each_key(*instruction,
+					 [&](const Key t_key)
+					 {
+						 auto& indices{postings[t_key]};
+						 if (indices.empty() || indices.back() != index)
+						 {
+							 indices.push_back(index);
+						 }
+					 });
+	}
+
+	std::vector<KeyEntry> entries;
+	std::vector<std::byte> encoded;
+	for (const auto& [key, indices] : postings)
+	{
+		entries.push_back({key, encoded.size(), indices.size()});
+		encode_postings(indices, encoded);
+	}
+
+	std::ofstream file(t_path, std::ios::binary);
+	write_struct(file, FileHeader{.magic = file_magic,
+								  .version = file_version,
+								  .base_address = t_base.get(),
+								  .word_count = t_words.size(),
+								  .key_count = entries.size()});
+	for (const auto& entry : entries)
+	{
+		write_struct(file, entry);
+	}
+	file.write(reinterpret_cast<const char*>(encoded.data()),
+			   static_cast<std::streamsize>(encoded.size()));
+
+	if (!file)
+	{
+		throw std::runtime_error(std::format("Cannot write {}", t_path.string()));
+	}
+}
+
+/*
+	Queries are conjunctions of clauses, each clause matching any of its keys
+*/
+export using Clause = std::vector<Key>;
+export using Query = std::vector<Clause>;
+
+export class InstructionIndex
+{
+public:
+	explicit InstructionIndex(const std::filesystem::path& t_path)
+		: m_file(t_path), m_header(read_struct<FileHeader>(m_file.bytes(), 0))
+	{
+		if (m_header.magic != file_magic || m_header.version != file_version)
+		{
+			throw std::runtime_error(std::format("{} is not an instruction index", t_path.string()));
+		}
+
+		// Checked before multiplying, a corrupt count must not wrap around to a small size
+		if (m_header.key_count > (m_file.bytes().size() - sizeof(FileHeader)) / sizeof(KeyEntry))
+		{
+			throw std::runtime_error("Truncated index");
+		}
+		const auto keys_size{m_header.key_count * sizeof(KeyEntry)};
+
+		m_keys = m_file.bytes().subspan(sizeof(FileHeader), keys_size);
+		m_postings = m_file.bytes().subspan(sizeof(FileHeader) + keys_size);
+	}
+
+	[[nodiscard]] auto base() const noexcept { return Address(m_header.base_address); }
+	[[nodiscard]] auto word_count() const noexcept { return m_header.word_count; }
+
+	// Sorted word indices of every instruction with the key
+	[[nodiscard]] auto find(const Key t_key) const -> std::vector<std::uint32_t>
+	{
+		// Binary search over the sorted key entries
+		std::size_t low{};
+		std::size_t high{m_header.key_count};
+		while (low < high)
+		{
+			const auto middle{low + ((high - low) / 2)};
+			const auto entry{read_struct<KeyEntry>(m_keys, middle * sizeof(KeyEntry))};
+
+			if (entry.key == t_key)
+			{
+				if (entry.offset > m_postings.size())
+				{
+					throw std::runtime_error("Corrupt index");
+				}
+				return decode_postings(m_postings.subspan(entry.offset), entry.count);
+			}
+
+			if (entry.key < t_key)
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+
+		return {};
+	}
+
+	[[nodiscard]] auto query(const Query& t_query) const -> std::vector<std::uint32_t>
+	{
+		std::vector<std::vector<std::uint32_t>> clause_results;
+		for (const auto& clause : t_query)
+		{
+			std::vector<std::uint32_t> united;
+			for (const auto key : clause)
+			{
+				const auto indices{find(key)};
+
+				std::vector<std::uint32_t> merged;
+				merged.reserve(united.size() + indices.size());
+				std::ranges::set_union(united, indices, std::back_inserter(merged));
+				united = std::move(merged);
+			}
+			clause_results.push_back(std::move(united));
+		}
+
+		if (clause_results.empty())
+		{
+			return {};
+		}
+
+		// Intersect the smallest lists first
+		std::ranges::sort(clause_results, std::ranges::less(), &std::vector<std::uint32_t>::size);
+
+		auto result{std::move(clause_results.front())};
+		for (const auto& indices : clause_results | std::views::drop(1))
+		{
+			std::vector<std::uint32_t> intersection;
+			std::ranges::set_intersection(result, indices, std::back_inserter(intersection));
+			result = std::move(intersection);
+		}
+
+		return result;
+	}
+
+private:
+	MappedFile m_file;
+	FileHeader m_header;
+	std::span<const std::byte> m_keys;
+	std::span<const std::byte> m_postings;
+};
+
+/*
+	Query parsing
+
+	Terms have the form <kind>:<value>, for example op:mov, write:pc or cond:ne. Alternatives
+	within a clause are separated by '|'.
+*/
+constexpr std::array<std::string_view, 18> operation_names{
+	"bx",  "b",	  "dp",	 "mrs", "msr", "mul", "ldr", "str", "ldm",
+	"stm", "swp", "swi", "cdp", "ldc", "stc", "mrc", "mcr", "undefined"};
+constexpr std::array<std::string_view, 16> op_code_names{
+	"and", "eor", "sub", "rsb", "add", "adc", "sbc", "rsc",
+	"tst", "teq", "cmp", "cmn", "orr", "mov", "bic", "mvn"};
+constexpr std::array<std::string_view, 16> condition_names{
+	"eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "al", "nv"};
+constexpr std::array<std::string_view, 18> register_names{
+	"r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "r11", "r12",
+	"sp", "lr", "pc", "cpsr", "spsr"};
+
+[[nodiscard]] auto parse_term(const std::string_view t_term) -> Key
+{
+	const auto invalid{[&] { return std::invalid_argument(std::format("Invalid term: {}", t_term)); }};
+
+	const auto separator{t_term.find(':')};
+	if (separator == std::string_view::npos)
+	{
+		throw invalid();
+	}
+
+	const auto kind{t_term.substr(0, separator)};
+	const auto value{t_term.substr(separator + 1)};
+
+	const auto find_name{[&](const std::span<const std::string_view> t_names)
+						 {
+							 const auto found{std::ranges::find(t_names, value)};
+							 if (found == t_names.end())
+							 {
+								 throw invalid();
+							 }
+							 return static_cast<std::uint32_t>(found - t_names.begin());
+						 }};
+
+	if (kind == "operation")
+	{
+		return make_key(KeyKind::Operation, find_name(operation_names));
+	}
+	if (kind == "op")
+	{
+		return make_key(KeyKind::OpCode, find_name(op_code_names));
+	}
+	if (kind == "cond")
+	{
+		return make_key(KeyKind::Condition, find_name(condition_names));
+	}
+	if (kind == "read" || kind == "write")
+	{
+		// r13-r15 are also accepted by number
+		const auto aliases{std::array<std::string_view, 3>{"r13", "r14", "r15"}};
+		const auto alias{std::ranges::find(aliases, value)};
+		const auto index{alias != aliases.end()
+							 ? static_cast<std::uint32_t>(13 + (alias - aliases.begin()))
+							 : find_name(register_names)};
+		return make_key(kind == "read" ? KeyKind::Reads : KeyKind::Writes, index);
+	}
+	if (kind == "imm")
+	{
+		const auto is_hexadecimal{value.starts_with("0x") || value.starts_with("0X")};
+		const auto digits{is_hexadecimal ? value.substr(2) : value};
+
+		std::uint32_t immediate{};
+		const auto [end, error]{std::from_chars(digits.data(), digits.data() + digits.size(),
+												immediate, is_hexadecimal ? 16 : 10)};
+		if (error != std::errc() || digits.empty() || end != digits.data() + digits.size())
+		{
+			throw invalid();
+		}
+		return make_key(KeyKind::Immediate, immediate);
+	}
+
+	throw invalid();
+}
+
+export [[nodiscard]] auto parse_query(const std::span<const std::string_view> t_terms)
+{
+	Query query;
+	for (const auto term : t_terms)
+	{
+		Clause clause;
+		for (const auto alternative : std::views::split(term, '|'))
+		{
+			clause.push_back(parse_term(std::string_view(alternative)));
+		}
+		query.push_back(std::move(clause));
+	}
+
+	return query;
+}
+
+} // namespace dzl::index
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,96 @@
+export module instruction_views;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import arm_instruction;
+import instruction_formatting;
+import disassembly;
+
+namespace dzl::views
+{
+template <typename Range>
+concept WordRange = std::ranges::viewable_range<Range> &&
+					std::same_as<std::ranges::range_value_t<Range>, Word>;
+
+template <typename Range>
+concept InstructionRange = std::ranges::viewable_range<Range> &&
+						   std::same_as<std::ranges::range_value_t<Range>, ins::Instruction>;
+
+/*
+	Words of a raw byte span, assembled only when accessed
+*/
+export [[nodiscard]] constexpr auto words(const std::span<const std::byte> t_bytes,
+										  const std::endian t_endianness)
+{
+	return std::views::iota(0UZ, t_bytes.size() / sizeof(Word)) |
+		   std::views::transform(
+			   [t_bytes, t_endianness](const std::size_t t_index)
+			   {
+				   std::array<std::byte, sizeof(Word)> bytes;
+				   std::ranges::copy(t_bytes.subspan(t_index * sizeof(Word), sizeof(Word)),
+									 bytes.begin());
+				   if (t_endianness != std::endian::native)
+				   {
+					   std::ranges::reverse(bytes);
+				   }
+				   return Word(std::bit_cast<Word::Underlying>(bytes));
+			   });
+}
+
+/*
+	Words to instructions, decoded on access. decode throws for words that cannot be decoded,
+	try_decode yields std::nullopt for them instead.
+*/
+struct DecodeAdaptor : std::ranges::range_adaptor_closure<DecodeAdaptor>
+{
+	template <WordRange Range> [[nodiscard]] constexpr auto operator()(Range&& t_range) const
+	{
+		return std::views::transform(std::forward<Range>(t_range),
+									 [](const Word t_word) { return fmt::arm::decode(t_word); });
+	}
+};
+
+struct TryDecodeAdaptor : std::ranges::range_adaptor_closure<TryDecodeAdaptor>
+{
+	template <WordRange Range> [[nodiscard]] constexpr auto operator()(Range&& t_range) const
+	{
+		return std::views::transform(std::forward<Range>(t_range), [](const Word t_word)
+									 { return fmt::arm::try_decode(t_word); });
+	}
+};
+
+/*
+	Words or instructions to text lines (without the newline), formatted on access. Words that
+	cannot be decoded become .word directives.
+*/
+struct FormatAdaptor : std::ranges::range_adaptor_closure<FormatAdaptor>
+{
+	template <WordRange Range> [[nodiscard]] constexpr auto operator()(Range&& t_range) const
+	{
+		return std::views::transform(std::forward<Range>(t_range),
+									 [](const Word t_word)
+									 {
+										 std::string line;
+										 format_word(t_word, line);
+										 line.pop_back();
+										 return line;
+									 });
+	}
+
+	template <InstructionRange Range> [[nodiscard]] constexpr auto operator()(Range&& t_range) const
+	{
+		return std::views::transform(std::forward<Range>(t_range),
+									 [](const ins::Instruction t_instruction)
+									 { return std::format("{}", t_instruction); });
+	}
+};
+
+export constexpr DecodeAdaptor decode{};
+export constexpr TryDecodeAdaptor try_decode{};
+export constexpr FormatAdaptor format{};
+
+} // namespace dzl::views
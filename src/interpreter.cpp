@@ -0,0 +1,771 @@
+export module interpreter;
+
+import std;
+
+import strong_type;
+import unsigned_integer;
+import bit_manipulation;
+import packed_struct;
+
+import types;
+import shift_operand;
+import instruction;
+import arm_instruction;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::emu
+{
+export using RegisterFile = std::array<Word, 16>;
+
+/*
+	Flat, little-endian memory starting at a base address
+*/
+export class Memory
+{
+public:
+	Memory(const Address t_base, const std::size_t t_size) : m_base(t_base), m_bytes(t_size) {}
+
+	Memory(const Address t_base, const std::span<const Word> t_words)
+		: m_base(t_base), m_bytes(t_words.size() * sizeof(Word))
+	{
+		for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+		{
+			write_word(t_base + AddressOffset(static_cast<AddressOffset::Underlying>(i_word * 4U)),
+					   t_words[i_word]);
+		}
+	}
+
+	[[nodiscard]] auto base() const noexcept { return m_base; }
+	[[nodiscard]] auto size() const noexcept { return m_bytes.size(); }
+
+	[[nodiscard]] auto contains(const Address t_address, const std::size_t t_size) const noexcept
+	{
+		const auto offset{static_cast<std::size_t>((t_address - m_base).get())};
+		return t_address >= m_base && offset + t_size <= m_bytes.size();
+	}
+
+	[[nodiscard]] auto read_word(const Address t_address) const
+	{
+		const auto offset{checked_offset(t_address)};
+
+		Word::Underlying value{};
+		for (std::size_t i_byte{}; i_byte < sizeof(Word); ++i_byte)
+		{
+			const auto byte{static_cast<Word::Underlying>(m_bytes[offset + i_byte].get())};
+			value |= static_cast<Word::Underlying>(byte << (8U * i_byte));
+		}
+
+		return Word(value);
+	}
+
+	auto write_word(const Address t_address, const Word t_value) -> void
+	{
+		const auto offset{checked_offset(t_address)};
+
+		for (std::size_t i_byte{}; i_byte < sizeof(Word); ++i_byte)
+		{
+			const BitRange byte_range(BitIndex(8U * i_byte), 8_bs);
+			m_bytes[offset + i_byte] = Byte(static_cast<Byte::Underlying>(
+				get_bits<UbChecked::Unchecked>(t_value, byte_range).get()));
+		}
+	}
+
+private:
+	[[nodiscard]] auto checked_offset(const Address t_address) const
+	{
+		if (!is_word_aligned(t_address) || !contains(t_address, sizeof(Word)))
+		{
+			throw std::out_of_range("Memory access outside of mapped range");
+		}
+
+		return static_cast<std::size_t>((t_address - m_base).get());
+	}
+
+	Address m_base;
+	std::vector<Byte> m_bytes;
+};
+
+/*
+	Program status register flags
+*/
+constexpr auto overflow_bit{28_bi};
+constexpr auto carry_bit{29_bi};
+constexpr auto zero_bit{30_bi};
+constexpr auto negative_bit{31_bi};
+constexpr BitRange flags_range(28_bi, 4_bs);
+
+[[nodiscard]] constexpr auto make_flags(const bool t_negative, const bool t_zero,
+										const bool t_carry, const bool t_overflow) noexcept
+{
+	const auto flags{(static_cast<unsigned>(t_negative) << 3U) |
+					 (static_cast<unsigned>(t_zero) << 2U) |
+					 (static_cast<unsigned>(t_carry) << 1U) | static_cast<unsigned>(t_overflow)};
+	return Word(static_cast<Word::Underlying>(flags));
+}
+
+// Bit n of entry c is set when condition c passes with NZCV == n
+constexpr auto condition_table{[]
+							   {
+								   std::array<std::uint16_t, 16> table{};
+								   for (unsigned flags{}; flags < 16U; ++flags)
+								   {
+									   const bool n{(flags & 8U) != 0U};
+									   const bool z{(flags & 4U) != 0U};
+									   const bool c{(flags & 2U) != 0U};
+									   const bool v{(flags & 1U) != 0U};
+
+									   const std::array passes{
+										   z,		   !z,		   c,  !c,	   //
+										   n,		   !n,		   v,  !v,	   //
+										   c && !z,	   !c || z,	   //
+										   n == v,	   n != v,	   //
+										   !z && n == v, z || n != v, //
+										   true,	   false};
+
+									   for (std::size_t i_condition{};
+											i_condition < passes.size(); ++i_condition)
+									   {
+										   if (passes[i_condition])
+										   {
+											   table[i_condition] |=
+												   static_cast<std::uint16_t>(1U << flags);
+										   }
+									   }
+								   }
+								   return table;
+							   }()};
+
+[[nodiscard]] constexpr auto condition_passed(const Condition t_condition,
+											  const Word t_cpsr) noexcept
+{
+	const auto flags{get_bits<UbChecked::Unchecked>(t_cpsr, flags_range).get()};
+	const auto passes{condition_table[static_cast<std::size_t>(t_condition)]};
+	return ((passes >> flags) & 1U) != 0U;
+}
+
+/*
+	Shift operand evaluation
+*/
+export struct ShifterResult
+{
+	Word value;
+	bool carry;
+};
+
+[[nodiscard]] constexpr auto shift_by_immediate(const Word t_value, const ShiftType t_type,
+												const BitShiftAmount t_amount,
+												const bool t_carry) noexcept
+{
+	const auto amount{t_amount.get()};
+
+	switch (t_type)
+	{
+	case ShiftType::LogicalLeft:
+		if (amount == 0U)
+		{
+			return ShifterResult{t_value, t_carry};
+		}
+		return ShifterResult{t_value << t_amount, get_bit(t_value, BitIndex(32U - amount))};
+
+	case ShiftType::LogicalRight:
+		// An encoded amount of zero is decoded as 32
+		if (amount >= 32U)
+		{
+			return ShifterResult{0_u32, get_bit(t_value, 31_bi)};
+		}
+		return ShifterResult{t_value >> t_amount, get_bit(t_value, BitIndex(amount - 1U))};
+
+	case ShiftType::ArithmeticRight:
+		if (amount >= 32U)
+		{
+			const auto sign{get_bit(t_value, 31_bi)};
+			return ShifterResult{sign ? ~0_u32 : 0_u32, sign};
+		}
+		return ShifterResult{arithmetic_shift_right(t_value, t_amount),
+							 get_bit(t_value, BitIndex(amount - 1U))};
+
+	case ShiftType::RotateRight:
+		if (amount == 0U)
+		{
+			return ShifterResult{t_value, t_carry};
+		}
+		return ShifterResult{rotate_right(t_value, t_amount),
+							 get_bit(t_value, BitIndex(amount - 1U))};
+
+	case ShiftType::RotateRightExtended:
+	{
+		const auto carry_in{t_carry ? 0x8000'0000_u32 : 0_u32};
+		return ShifterResult{carry_in | (t_value >> 1_sh), get_bit(t_value, 0_bi)};
+	}
+
+	default:
+		std::unreachable();
+	}
+}
+
+// Only the bottom byte of the amount register is used
+[[nodiscard]] constexpr auto shift_by_register(const Word t_value, const ShiftType t_type,
+											   const Word t_amount, const bool t_carry) noexcept
+{
+	const auto amount{get_bits<UbChecked::Unchecked>(t_amount, {0_bi, 8_bs}).get()};
+
+	if (amount == 0U)
+	{
+		return ShifterResult{t_value, t_carry};
+	}
+
+	switch (t_type)
+	{
+	case ShiftType::LogicalLeft:
+		if (amount < 32U)
+		{
+			return shift_by_immediate(t_value, t_type, BitShiftAmount(amount), t_carry);
+		}
+		return ShifterResult{0_u32, amount == 32U && get_bit(t_value, 0_bi)};
+
+	case ShiftType::LogicalRight:
+		if (amount < 32U)
+		{
+			return shift_by_immediate(t_value, t_type, BitShiftAmount(amount), t_carry);
+		}
+		return ShifterResult{0_u32, amount == 32U && get_bit(t_value, 31_bi)};
+
+	case ShiftType::ArithmeticRight:
+		return shift_by_immediate(t_value, t_type, BitShiftAmount(std::min(amount, 32U)),
+								  t_carry);
+
+	case ShiftType::RotateRight:
+	{
+		const auto rotation{amount % 32U};
+		if (rotation == 0U)
+		{
+			return ShifterResult{t_value, get_bit(t_value, 31_bi)};
+		}
+		return shift_by_immediate(t_value, t_type, BitShiftAmount(rotation), t_carry);
+	}
+
+	default:
+		std::unreachable();
+	}
+}
+
+// Reads of the pc must already include the pipeline offset of 8
+export [[nodiscard]] constexpr auto evaluate(const ShiftOperand t_operand,
+											 const RegisterFile& t_registers,
+											 const bool t_carry) noexcept
+{
+	switch (t_operand.get_type())
+	{
+	case ShiftOperandType::Immediate:
+	{
+		const auto [type, value]{t_operand.get<ImmediateOperand>()};
+		return ShifterResult{Word(value.get()), t_carry};
+	}
+	case ShiftOperandType::RotatedImmediate:
+	{
+		const auto [type, source, amount]{t_operand.get<RotatedImmediateOperand>()};
+
+		const auto value{rotate_right(Word(source.get()), amount)};
+		const auto carry{amount == 0_sh ? t_carry : get_bit(value, 31_bi)};
+		return ShifterResult{value, carry};
+	}
+	case ShiftOperandType::ImmediateShiftedRegister:
+	{
+		const auto [type, source, shift_type,
+					amount]{t_operand.get<ImmediateShiftedRegisterOperand>()};
+
+		const auto value{t_registers[static_cast<std::size_t>(source)]};
+		return shift_by_immediate(value, shift_type, amount, t_carry);
+	}
+	case ShiftOperandType::RegisterShiftedRegister:
+	{
+		const auto [type, source, shift_type,
+					amount]{t_operand.get<RegisterShiftedRegisterOperand>()};
+
+		// The pc reads one instruction further ahead when the shift is register-specified
+		const auto pipeline_offset{source == Register::Pc ? 4_u32 : 0_u32};
+		const auto value{t_registers[static_cast<std::size_t>(source)] + pipeline_offset};
+		const auto amount_value{t_registers[static_cast<std::size_t>(amount)]};
+		return shift_by_register(value, shift_type, amount_value, t_carry);
+	}
+	default:
+		std::unreachable();
+	}
+}
+
+/*
+	Execution state shared by the handlers
+*/
+struct State
+{
+	RegisterFile registers{};
+	Word cpsr{};
+	Word spsr{};
+
+	// Set whenever a handler writes the pc
+	bool branched{};
+
+	[[nodiscard]] constexpr auto get(const Register t_register) const noexcept
+	{
+		switch (t_register)
+		{
+		case Register::Cpsr:
+			return cpsr;
+		case Register::Spsr:
+			return spsr;
+		default:
+			return registers[static_cast<std::size_t>(t_register)];
+		}
+	}
+
+	constexpr auto set(const Register t_register, const Word t_value) noexcept -> void
+	{
+		switch (t_register)
+		{
+		case Register::Cpsr:
+			cpsr = t_value;
+			return;
+		case Register::Spsr:
+			spsr = t_value;
+			return;
+		case Register::Pc:
+			branched = true;
+			[[fallthrough]];
+		default:
+			registers[static_cast<std::size_t>(t_register)] = t_value;
+		}
+	}
+
+	[[nodiscard]] constexpr auto carry() const noexcept { return get_bit(cpsr, carry_bit); }
+
+	constexpr auto set_flags(const Word t_flags) noexcept -> void
+	{
+		set_bits(cpsr, t_flags, flags_range);
+	}
+};
+
+using Handler = void (*)(State&, ins::Instruction);
+
+/*
+	Handlers
+*/
+struct AluResult
+{
+	Word value;
+	bool carry;
+	bool overflow;
+};
+
+[[nodiscard]] constexpr auto add_with_carry(const Word t_first, const Word t_second,
+											const bool t_carry) noexcept
+{
+	const auto wide{static_cast<std::uint64_t>(t_first.get()) + t_second.get() +
+					static_cast<std::uint64_t>(t_carry)};
+	const Word result(static_cast<Word::Underlying>(wide));
+
+	const auto carry{(wide >> 32U) != 0U};
+	const auto overflow{get_bit((t_first ^ result) & (t_second ^ result), 31_bi)};
+	return AluResult{result, carry, overflow};
+}
+
+template <ins::DataProcessingOpCode op_code>
+auto execute_data_processing(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	using enum ins::DataProcessingOpCode;
+
+	const auto [operation, condition, encoded_op_code, set_condition_codes, destination, first,
+				second]{t_instruction.get<ins::DataProcessing>()};
+
+	const auto [operand, shifter_carry]{evaluate(second, t_state.registers, t_state.carry())};
+	const auto first_value{t_state.get(first)};
+	const auto overflow{get_bit(t_state.cpsr, overflow_bit)};
+
+	constexpr static auto is_comparison{op_code == Tst || op_code == Teq || op_code == Cmp ||
+										op_code == Cmn};
+
+	const auto result{[&]
+					  {
+						  if constexpr (op_code == And || op_code == Tst)
+						  {
+							  return AluResult{first_value & operand, shifter_carry, overflow};
+						  }
+						  else if constexpr (op_code == Eor || op_code == Teq)
+						  {
+							  return AluResult{first_value ^ operand, shifter_carry, overflow};
+						  }
+						  else if constexpr (op_code == Sub || op_code == Cmp)
+						  {
+							  return add_with_carry(first_value, ~operand, true);
+						  }
+						  else if constexpr (op_code == Rsb)
+						  {
+							  return add_with_carry(operand, ~first_value, true);
+						  }
+						  else if constexpr (op_code == Add || op_code == Cmn)
+						  {
+							  return add_with_carry(first_value, operand, false);
+						  }
+						  else if constexpr (op_code == Adc)
+						  {
+							  return add_with_carry(first_value, operand, t_state.carry());
+						  }
+						  else if constexpr (op_code == Sbc)
+						  {
+							  return add_with_carry(first_value, ~operand, t_state.carry());
+						  }
+						  else if constexpr (op_code == Rsc)
+						  {
+							  return add_with_carry(operand, ~first_value, t_state.carry());
+						  }
+						  else if constexpr (op_code == Orr)
+						  {
+							  return AluResult{first_value | operand, shifter_carry, overflow};
+						  }
+						  else if constexpr (op_code == Mov)
+						  {
+							  return AluResult{operand, shifter_carry, overflow};
+						  }
+						  else if constexpr (op_code == Bic)
+						  {
+							  return AluResult{first_value & ~operand, shifter_carry, overflow};
+						  }
+						  else
+						  {
+							  return AluResult{~operand, shifter_carry, overflow};
+						  }
+					  }()};
+
+	if constexpr (!is_comparison)
+	{
+		t_state.set(destination, result.value);
+	}
+
+	if (set_condition_codes)
+	{
+		// Writing the pc with flags restores the saved status
+		if (!is_comparison && destination == Register::Pc)
+		{
+			t_state.cpsr = t_state.spsr;
+			return;
+		}
+
+		t_state.set_flags(make_flags(get_bit(result.value, 31_bi), result.value == 0_u32,
+									 result.carry, result.overflow));
+	}
+}
+
+constexpr auto data_processing_handlers{[]<std::size_t... op_codes>(std::index_sequence<op_codes...>)
+										{
+											return std::array<Handler, sizeof...(op_codes)>{
+												&execute_data_processing<
+													static_cast<ins::DataProcessingOpCode>(
+														op_codes)>...};
+										}(std::make_index_sequence<16>())};
+
+auto execute_branch_and_exchange(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	const auto [operation, condition, destination]{t_instruction.get<ins::BranchAndExchange>()};
+
+	const auto target{t_state.get(destination)};
+	if (get_bit(target, 0_bi))
+	{
+		throw std::runtime_error("Thumb state not supported");
+	}
+
+	t_state.set(Register::Pc, target);
+}
+
+auto execute_branch(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	const auto [operation, condition, link, offset]{t_instruction.get<ins::Branch>()};
+
+	const auto pc{t_state.get(Register::Pc)};
+	if (link)
+	{
+		t_state.set(Register::Lr, pc - 4_u32);
+	}
+
+	t_state.set(Register::Pc, pc + Word(offset.get()));
+}
+
+auto execute_move_from_psr(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	const auto [operation, condition, destination, source]{
+		t_instruction.get<ins::MoveFromPsr>()};
+
+	t_state.set(destination, t_state.get(source));
+}
+
+auto execute_move_to_psr(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	const auto [operation, condition, destination, source, flags_only]{
+		t_instruction.get<ins::MoveToPsr>()};
+
+	const auto value{evaluate(source, t_state.registers, t_state.carry()).value};
+	if (!flags_only)
+	{
+		t_state.set(destination, value);
+		return;
+	}
+
+	auto psr{t_state.get(destination)};
+	set_bits(psr, get_bits<UbChecked::Unchecked>(value, flags_range), flags_range);
+	t_state.set(destination, psr);
+}
+
+auto execute_multiply(State& t_state, const ins::Instruction t_instruction) -> void
+{
+	const auto [operation, condition, destination, accumulator, first, second,
+				set_condition_codes, accumulate, is_long, is_unsigned]{
+		t_instruction.get<ins::Multiply>()};
+
+	const auto first_value{t_state.get(first).get()};
+	const auto second_value{t_state.get(second).get()};
+
+	if (!is_long)
+	{
+		auto result{Word(static_cast<Word::Underlying>(first_value * second_value))};
+		if (accumulate)
+		{
+			result += t_state.get(accumulator);
+		}
+
+		t_state.set(destination, result);
+		if (set_condition_codes)
+		{
+			t_state.set_flags(make_flags(get_bit(result, 31_bi), result == 0_u32,
+										 t_state.carry(), get_bit(t_state.cpsr, overflow_bit)));
+		}
+		return;
+	}
+
+	auto result{is_unsigned ? static_cast<std::uint64_t>(first_value) * second_value
+							: static_cast<std::uint64_t>(
+								  static_cast<std::int64_t>(static_cast<std::int32_t>(first_value)) *
+								  static_cast<std::int32_t>(second_value))};
+	if (accumulate)
+	{
+		result += (static_cast<std::uint64_t>(t_state.get(destination).get()) << 32U) |
+				  t_state.get(accumulator).get();
+	}
+
+	const Unsigned<8> wide_result(result);
+	t_state.set(destination, Word(static_cast<Word::Underlying>(result >> 32U)));
+	t_state.set(accumulator, Word(static_cast<Word::Underlying>(result)));
+	if (set_condition_codes)
+	{
+		t_state.set_flags(make_flags(get_bit(wide_result, 63_bi), result == 0U, t_state.carry(),
+									 get_bit(t_state.cpsr, overflow_bit)));
+	}
+}
+
+[[noreturn]] auto execute_unsupported(State& /*t_state*/, const ins::Instruction /*t_instruction*/)
+	-> void
+{
+	throw std::runtime_error("Operation not implemented");
+}
+
+// Resolved once per instruction when a block is predecoded
+[[nodiscard]] auto resolve_handler(const ins::Instruction t_instruction) noexcept -> Handler
+{
+	switch (t_instruction.get_operation())
+	{
+	case ins::Operation::BranchAndExchange:
+		return &execute_branch_and_exchange;
+	case ins::Operation::Branch:
+		return &execute_branch;
+	case ins::Operation::DataProcessing:
+	{
+		const auto [operation, condition, op_code, set_condition_codes, destination, first,
+					second]{t_instruction.get<ins::DataProcessing>()};
+		return data_processing_handlers[static_cast<std::size_t>(op_code)];
+	}
+	case ins::Operation::MoveFromPsr:
+		return &execute_move_from_psr;
+	case ins::Operation::MoveToPsr:
+		return &execute_move_to_psr;
+	case ins::Operation::Multiply:
+		return &execute_multiply;
+	default:
+		return &execute_unsupported;
+	}
+}
+
+// Whether executing the instruction may write the pc
+[[nodiscard]] constexpr auto ends_block(const ins::Instruction t_instruction) noexcept
+{
+	switch (t_instruction.get_operation())
+	{
+	case ins::Operation::BranchAndExchange:
+	case ins::Operation::Branch:
+		return true;
+	case ins::Operation::DataProcessing:
+	{
+		const auto [operation, condition, op_code, set_condition_codes, destination, first,
+					second]{t_instruction.get<ins::DataProcessing>()};
+		return destination == Register::Pc;
+	}
+	case ins::Operation::MoveFromPsr:
+	{
+		const auto [operation, condition, destination, source]{
+			t_instruction.get<ins::MoveFromPsr>()};
+		return destination == Register::Pc;
+	}
+	case ins::Operation::Multiply:
+	{
+		const auto [operation, condition, destination, accumulator, first, second,
+					set_condition_codes, accumulate, is_long, is_unsigned]{
+			t_instruction.get<ins::Multiply>()};
+		return destination == Register::Pc || (is_long && accumulator == Register::Pc);
+	}
+	default:
+		return false;
+	}
+}
+
+/*
+	Predecoded straight-line code
+*/
+struct PredecodedInstruction
+{
+	Handler handler;
+	ins::Instruction instruction;
+};
+
+struct Block
+{
+	Address start;
+	std::vector<PredecodedInstruction> instructions;
+};
+
+constexpr std::size_t max_block_size{64};
+
+export class Interpreter
+{
+public:
+	explicit Interpreter(Memory t_memory) : m_memory(std::move(t_memory)) {}
+
+	[[nodiscard]] auto get_register(const Register t_register) const noexcept
+	{
+		return m_state.get(t_register);
+	}
+	auto set_register(const Register t_register, const Word t_value) noexcept -> void
+	{
+		m_state.set(t_register, t_value);
+	}
+
+	[[nodiscard]] auto get_memory() const noexcept -> const Memory& { return m_memory; }
+
+	// Invalidates every cached block, since code may have been overwritten
+	auto write_word(const Address t_address, const Word t_value) -> void
+	{
+		m_memory.write_word(t_address, t_value);
+		m_blocks.clear();
+	}
+
+	/*
+		Executes from the current pc until the limit is reached or the stop address is about to
+		be executed. Returns the number of executed instructions, including those whose
+		condition failed.
+	*/
+	auto run(const std::size_t t_instruction_limit,
+			 const std::optional<Address> t_stop_address = std::nullopt) -> std::size_t
+	{
+		std::size_t executed{};
+		auto next{Address(m_state.registers[15].get())};
+
+		while (executed < t_instruction_limit && next != t_stop_address)
+		{
+			const auto& block{get_block(next)};
+
+			auto address{block.start};
+			for (const auto& [handler, instruction] : block.instructions)
+			{
+				if (executed == t_instruction_limit || address == t_stop_address)
+				{
+					break;
+				}
+
+				m_state.registers[15] = Word((address + 8_off).get());
+				m_state.branched = false;
+
+				if (condition_passed(instruction.get_condition(), m_state.cpsr))
+				{
+					handler(m_state, instruction);
+				}
+				++executed;
+
+				if (m_state.branched)
+				{
+					address = Address(m_state.registers[15].get() & ~3U);
+					break;
+				}
+				address = address + 4_off;
+			}
+
+			next = address;
+		}
+
+		m_state.registers[15] = Word(next.get());
+		return executed;
+	}
+
+private:
+	auto get_block(const Address t_start) -> const Block&
+	{
+		const auto [iterator, inserted]{m_blocks.try_emplace(t_start.get())};
+		if (inserted)
+		{
+			try
+			{
+				iterator->second = predecode(t_start);
+			}
+			catch (...)
+			{
+				m_blocks.erase(iterator);
+				throw;
+			}
+		}
+
+		return iterator->second;
+	}
+
+	[[nodiscard]] auto predecode(const Address t_start) const -> Block
+	{
+		Block block{.start = t_start, .instructions = {}};
+
+		auto address{t_start};
+		while (block.instructions.size() < max_block_size && m_memory.contains(address, 4U))
+		{
+			const auto instruction{fmt::arm::try_decode(m_memory.read_word(address))};
+			if (!instruction)
+			{
+				break;
+			}
+
+			block.instructions.push_back({resolve_handler(*instruction), *instruction});
+			if (ends_block(*instruction))
+			{
+				break;
+			}
+			address = address + 4_off;
+		}
+
+		if (block.instructions.empty())
+		{
+			throw std::runtime_error(
+				std::format("Cannot execute instruction at {:#010x}", t_start.get()));
+		}
+
+		return block;
+	}
+
+	State m_state;
+	Memory m_memory;
+	std::unordered_map<Address::Underlying, Block> m_blocks;
+};
+
+} // namespace dzl::emu
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,193 @@
+export module listing;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import instruction_formatting;
+import data_classifier;
+import disassembly;
+import symbol_table;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::listing
+{
+export struct Options
+{
+	// Appends the absolute target address to every branch
+	bool branch_targets{};
+
+	// Also names branch targets after the symbol at or before them, implying branch_targets
+	const symbols::SymbolTable* symbols{};
+};
+
+/*
+	Hexadecimal rendering through a table of digit pairs, one entry per byte
+*/
+constexpr auto hex_pairs{[]
+						 {
+							 constexpr std::string_view digits{"0123456789abcdef"};
+
+							 std::array<std::array<char, 2>, 256> pairs{};
+							 for (std::size_t i_byte{}; i_byte < pairs.size(); ++i_byte)
+							 {
+								 pairs[i_byte] = {digits[i_byte >> 4U], digits[i_byte & 0xFU]};
+							 }
+							 return pairs;
+						 }()};
+
+// Writes exactly eight lowercase digits and returns the end of them
+export constexpr auto write_hex(const Word t_value, char* const t_output) noexcept -> char*
+{
+	const auto value{t_value.get()};
+	for (std::size_t i_byte{}; i_byte < sizeof(value); ++i_byte)
+	{
+		const auto shift{8 * (sizeof(value) - 1 - i_byte)};
+		const auto pair{hex_pairs[(value >> shift) & 0xFFU]};
+		t_output[2 * i_byte] = pair[0];
+		t_output[(2 * i_byte) + 1] = pair[1];
+	}
+	return t_output + 8;
+}
+
+/*
+	Line layout: "aaaaaaaa:  wwwwwwww  mnemonic operands[  ; tttttttt[ <symbol+0x1c>]]"
+*/
+constexpr std::size_t mnemonic_width{8};
+constexpr std::size_t max_line_size{128};
+// Address, word and their separators
+constexpr std::size_t prefix_size{21};
+constexpr std::size_t branch_target_size{12};
+// " <" name "+0x" offset ">", apart from the name
+constexpr std::size_t symbol_reference_size{14};
+// Room left for the instruction text, its operand alignment, a branch target and the newline
+constexpr std::size_t max_text_size{max_line_size - prefix_size - mnemonic_width -
+									branch_target_size - 1};
+
+constexpr auto append(char* const t_output, const std::string_view t_text) noexcept -> char*
+{
+	return std::ranges::copy(t_text, t_output).out;
+}
+
+// Pads the mnemonic (up to the first space) so that the operands start in the same column
+auto align_operands(char* const t_text, char* const t_end) noexcept -> char*
+{
+	auto* const space{std::find(t_text, t_end, ' ')};
+	const auto mnemonic_size{static_cast<std::size_t>(space - t_text)};
+	if (space == t_end || mnemonic_size + 1 >= mnemonic_width)
+	{
+		return t_end;
+	}
+
+	const auto padding{static_cast<std::ptrdiff_t>(mnemonic_width - mnemonic_size - 1)};
+	std::copy_backward(space + 1, t_end, t_end + padding);
+	std::fill(space, space + padding + 1, ' ');
+	return t_end + padding;
+}
+
+// name or name+0x1c, with space for it reserved by the caller
+auto append_reference(char* t_output, const symbols::SymbolReference& t_reference) noexcept
+	-> char*
+{
+	t_output = append(t_output, " <");
+	t_output = append(t_output, t_reference.name);
+	if (t_reference.offset.get() != 0)
+	{
+		t_output = append(t_output, "+0x");
+		t_output = std::to_chars(t_output, t_output + 8, t_reference.offset.get(), 16).ptr;
+	}
+	*t_output++ = '>';
+	return t_output;
+}
+
+// Offsets are relative to the pipelined pc, two instructions ahead
+[[nodiscard]] constexpr auto branch_target(const Address t_address,
+										   const ins::Instruction t_instruction) noexcept
+{
+	const auto [operation, condition, link, offset]{t_instruction.get<ins::Branch>()};
+	return t_address + AddressOffset(8U) + offset;
+}
+
+// Appends the line of a single word, t_instruction being empty for data
+export auto append_line(const Address t_address, const Word t_word,
+				 const std::optional<ins::Instruction>& t_instruction, const Options& t_options,
+				 std::string& t_output) -> void
+{
+	const auto is_branch{t_instruction &&
+						 t_instruction->get_operation() == ins::Operation::Branch};
+	const auto target{is_branch && (t_options.branch_targets || t_options.symbols != nullptr)
+						  ? std::optional(branch_target(t_address, *t_instruction))
+						  : std::nullopt};
+	const auto reference{target && t_options.symbols != nullptr ? t_options.symbols->find(*target)
+																: std::nullopt};
+	const auto line_size{max_line_size +
+						 (reference ? symbol_reference_size + reference->name.size() : 0)};
+
+	const auto offset{t_output.size()};
+	t_output.resize_and_overwrite(
+		offset + line_size,
+		[&](char* const t_data, std::size_t) -> std::size_t
+		{
+			auto* output{write_hex(Word(t_address.get()), t_data + offset)};
+			output = append(output, ":  ");
+			output = write_hex(t_word, output);
+			output = append(output, "  ");
+
+			if (!t_instruction)
+			{
+				output = append(output, ".word   0x");
+				output = write_hex(t_word, output);
+			}
+			else
+			{
+				auto* const text{output};
+				output = std::format_to_n(text, max_text_size, "{}", *t_instruction).out;
+				output = align_operands(text, output);
+
+				if (target)
+				{
+					output = append(output, "  ; ");
+					output = write_hex(Word(target->get()), output);
+				}
+				if (reference)
+				{
+					output = append_reference(output, *reference);
+				}
+			}
+
+			*output++ = '\n';
+			return static_cast<std::size_t>(output - t_data);
+		});
+}
+
+// Typical line length, used to size the output up front
+constexpr std::size_t expected_line_size{48};
+
+// Appends one line per word, words classified as data by t_kinds are listed as .word directives
+export auto list(const std::span<const Word> t_words,
+				 const std::span<const search::WordKind> t_kinds, const Address t_base,
+				 const Options& t_options, std::string& t_output) -> void
+{
+	t_output.reserve(t_output.size() + (t_words.size() * expected_line_size));
+
+	for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+	{
+		const Address address(static_cast<Address::Underlying>(t_base.get() + (4 * i_word)));
+		append_line(address, t_words[i_word], decode_classified(t_words[i_word], t_kinds[i_word]),
+					t_options, t_output);
+	}
+}
+
+// Classifies t_words as a whole image
+export auto list(const std::span<const Word> t_words, const Address t_base,
+				 const Options& t_options, std::string& t_output) -> void
+{
+	list(t_words, search::classify(t_words), t_base, t_options, t_output);
+}
+
+} // namespace dzl::listing
+
+// NOLINTEND(*-magic-numbers)
@@ -1,30 +1,586 @@
 import std;
 
 import unsigned_integer;
-import bit_manipulation;
-import packed_struct;
+import allocation_counter;
 
 import types;
-import shift_operand;
-import instruction;
 import arm_instruction;
-import instruction_formatting;
+import image;
+import data_classifier;
+import disassembly;
+import listing;
+import symbol_table;
+import batch;
+import result_cache;
+import pattern_search;
+import instruction_index;
+import function_scan;
+import image_diff;
+import pipeline;
+import output_sink;
+import server;
 
-auto main(const int t_argument_count, const char** t_arguments) -> int
+namespace
+{
+constexpr std::string_view usage{
+	"usage:\n"
+	"  arm_disassembler <image> [--base <address>] [--cache <directory> [--cache-size <bytes>]]\n"
+	"  arm_disassembler <image> --pipeline\n"
+	"  arm_disassembler <image> --listing [--branch-targets] [--symbols <file>] [--base <address>]\n"
+	"  arm_disassembler --batch <manifest|directory> <output-directory> [--threads <count>]\n"
+	"  arm_disassembler <image> --search <pattern> [--search <pattern>...]\n"
+	"  arm_disassembler <image> --functions [--base <address>]\n"
+	"  arm_disassembler --diff <old image> <new image> [--base <address>]\n"
+	"  arm_disassembler <image> --index <index-file>\n"
+	"  arm_disassembler --query <index-file> <term[|term...]>...\n"
+	"  arm_disassembler --serve <socket> <image>... [--base <address>] [--cache-size <bytes>]\n"
+	"options:\n"
+	"  --endian <little|big>  byte order of the input images (default: little)\n"
+	"  --stats                report the output throughput (and allocations, when counted)\n"
+	"  --symbols <file>       names branch targets, from an ELF32 file or <address> <name> lines\n"
+	"patterns:\n"
+	"  b, bl, bx-lr, swi, pc-write or <checked bits>:<required bits> in hexadecimal\n"
+	"terms (all arguments must match):\n"
+	"  operation:<b|bx|dp|mrs|msr|mul|...>, op:<mov|add|...>, cond:<eq|ne|...|al>,\n"
+	"  read:<register>, write:<register>, imm:<value>\n"};
+
+struct Options
+{
+	std::vector<std::string_view> positional;
+
+	bool batch{};
+	std::size_t thread_count{std::max(std::thread::hardware_concurrency(), 1U)};
+
+	dzl::Address base{};
+	std::endian endianness{std::endian::little};
+
+	std::vector<dzl::fmt::arm::FormatMask> search_patterns;
+
+	std::optional<std::filesystem::path> cache_directory;
+	std::uintmax_t cache_size{1ULL << 30U};
+
+	bool functions{};
+	bool diff{};
+	bool pipeline{};
+	bool statistics{};
+
+	bool listing{};
+	bool branch_targets{};
+	std::optional<std::filesystem::path> symbols_path;
+
+	std::optional<std::filesystem::path> socket_path;
+
+	std::optional<std::filesystem::path> index_path;
+	std::optional<std::filesystem::path> query_path;
+};
+
+// Accepts decimal and 0x-prefixed hexadecimal values
+[[nodiscard]] auto parse_unsigned(const std::string_view t_text) -> std::uint64_t
+{
+	const auto is_hexadecimal{t_text.starts_with("0x") || t_text.starts_with("0X")};
+	const auto digits{is_hexadecimal ? t_text.substr(2) : t_text};
+
+	std::uint64_t value{};
+	const auto [end, error]{std::from_chars(digits.data(), digits.data() + digits.size(), value,
+											is_hexadecimal ? 16 : 10)};
+	if (error != std::errc() || end != digits.data() + digits.size() || digits.empty())
+	{
+		throw std::invalid_argument(std::format("Invalid number: {}", t_text));
+	}
+
+	return value;
+}
+
+[[nodiscard]] auto parse_options(const std::span<const char* const> t_arguments)
+{
+	Options options;
+
+	for (std::size_t i_argument{1}; i_argument < t_arguments.size(); ++i_argument)
+	{
+		const std::string_view argument(t_arguments[i_argument]);
+
+		const auto next_value{[&]
+							  {
+								  if (++i_argument >= t_arguments.size())
+								  {
+									  throw std::invalid_argument(
+										  std::format("Missing value for {}", argument));
+								  }
+								  return std::string_view(t_arguments[i_argument]);
+							  }};
+
+		if (argument == "--batch")
+		{
+			options.batch = true;
+		}
+		else if (argument == "--threads")
+		{
+			options.thread_count = static_cast<std::size_t>(parse_unsigned(next_value()));
+		}
+		else if (argument == "--base")
+		{
+			options.base =
+				dzl::Address(static_cast<dzl::Address::Underlying>(parse_unsigned(next_value())));
+		}
+		else if (argument == "--endian")
+		{
+			const auto value{next_value()};
+			if (value != "little" && value != "big")
+			{
+				throw std::invalid_argument(std::format("Invalid byte order: {}", value));
+			}
+			options.endianness = value == "big" ? std::endian::big : std::endian::little;
+		}
+		else if (argument == "--search")
+		{
+			std::ranges::copy(dzl::search::parse_pattern(next_value()),
+							  std::back_inserter(options.search_patterns));
+		}
+		else if (argument == "--cache")
+		{
+			options.cache_directory = next_value();
+		}
+		else if (argument == "--cache-size")
+		{
+			options.cache_size = parse_unsigned(next_value());
+		}
+		else if (argument == "--functions")
+		{
+			options.functions = true;
+		}
+		else if (argument == "--listing")
+		{
+			options.listing = true;
+		}
+		else if (argument == "--branch-targets")
+		{
+			options.branch_targets = true;
+		}
+		else if (argument == "--symbols")
+		{
+			options.symbols_path = next_value();
+		}
+		else if (argument == "--serve")
+		{
+			options.socket_path = next_value();
+		}
+		else if (argument == "--stats")
+		{
+			options.statistics = true;
+		}
+		else if (argument == "--pipeline")
+		{
+			options.pipeline = true;
+		}
+		else if (argument == "--diff")
+		{
+			options.diff = true;
+		}
+		else if (argument == "--index")
+		{
+			options.index_path = next_value();
+		}
+		else if (argument == "--query")
+		{
+			options.query_path = next_value();
+		}
+		else if (argument.starts_with("--"))
+		{
+			throw std::invalid_argument(std::format("Unknown option: {}", argument));
+		}
+		else
+		{
+			options.positional.push_back(argument);
+		}
+	}
+
+	return options;
+}
+
+auto finish_output(const Options& t_options, dzl::io::OutputSink& t_sink) -> void
+{
+	t_sink.flush();
+	if (!t_options.statistics)
+	{
+		return;
+	}
+
+	const auto statistics{t_sink.statistics()};
+	const std::chrono::duration<double, std::milli> elapsed(statistics.elapsed);
+	std::println(std::cerr, "output: {} lines, {} bytes in {:.1f} ms ({:.0f} lines/s)",
+				 statistics.lines, statistics.bytes, elapsed.count(),
+				 statistics.lines_per_second());
+
+	if constexpr (dzl::memory::allocation_counting)
+	{
+		// Every line is one instruction or data word
+		const auto allocations{dzl::memory::process_allocations()};
+		const auto lines{static_cast<double>(std::max(statistics.lines, 1UZ))};
+		std::println(std::cerr,
+					 "allocations: {} ({:.3f} per instruction), {} bytes ({:.1f} per instruction)",
+					 allocations.allocations, static_cast<double>(allocations.allocations) / lines,
+					 allocations.bytes, static_cast<double>(allocations.bytes) / lines);
+	}
+}
+
+auto run_batch(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 2)
+	{
+		throw std::invalid_argument("Batch mode takes an input and an output directory");
+	}
+
+	const auto inputs{dzl::batch::collect_inputs(t_options.positional[0])};
+
+	const auto start{std::chrono::steady_clock::now()};
+	const auto reports{dzl::batch::run(inputs, t_options.positional[1], t_options.endianness,
+									   t_options.thread_count)};
+	const std::chrono::duration<double, std::milli> total_elapsed(
+		std::chrono::steady_clock::now() - start);
+
+	std::size_t failed_count{};
+	for (const auto& report : reports)
+	{
+		if (!report.error.empty())
+		{
+			std::println(std::cerr, "{}\tfailed: {}", report.input.string(), report.error);
+			++failed_count;
+			continue;
+		}
+
+		const std::chrono::duration<double, std::micro> elapsed(report.elapsed);
+		std::println(std::cerr, "{}\t{} words\t{:.1f} us", report.input.string(),
+					 report.word_count, elapsed.count());
+	}
+
+	// Wall clock time, files are disassembled concurrently
+	std::println(std::cerr, "{} files\t{:.1f} ms", reports.size(), total_elapsed.count());
+	if (failed_count != 0)
+	{
+		throw std::runtime_error(
+			std::format("{} of {} files failed", failed_count, reports.size()));
+	}
+}
+
+// Only the matching words are decoded
+auto run_search(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	const auto words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+	const auto matches{dzl::search::find_matches(words, t_options.search_patterns)};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	std::optional<std::size_t> previous_index;
+	for (const auto [index, pattern] : matches)
+	{
+		if (index == previous_index)
+		{
+			continue;
+		}
+		previous_index = index;
+
+		const auto address{t_options.base.get() +
+						   static_cast<dzl::Address::Underlying>(index * sizeof(dzl::Word))};
+		text.clear();
+		std::format_to(std::back_inserter(text), "{:08x}:  ", address);
+		dzl::format_word(words[index], text);
+		sink.write(text);
+	}
+	finish_output(t_options, sink);
+}
+
+// One line per function: name, address range and why it was found
+auto run_functions(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	const auto words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	for (const auto& function : dzl::search::find_functions(words, t_options.base))
+	{
+		text.clear();
+		std::format_to(std::back_inserter(text), "{}  {:08x}-{:08x}{}{}\n",
+					   dzl::search::function_name(function), function.start.get(),
+					   function.end.get(), function.has_prologue ? "  prologue" : "",
+					   function.is_call_target ? "  called" : "");
+		sink.write(text);
+	}
+	finish_output(t_options, sink);
+}
+
+// Unified diff style hunks of disassembly, one per change
+auto run_diff(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 2)
+	{
+		throw std::invalid_argument("Expected an old and a new image");
+	}
+
+	const auto old_words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+	const auto new_words{dzl::io::load_image(t_options.positional[1], t_options.endianness)};
+	const auto changes{dzl::diff::diff(old_words, new_words)};
+
+	const auto address_of{[&](const std::size_t t_index)
+						  {
+							  return t_options.base.get() + static_cast<dzl::Address::Underlying>(
+																t_index * sizeof(dzl::Word));
+						  }};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	std::size_t changed_word_count{};
+	for (const auto [old_begin, old_count, new_begin, new_count] : changes)
+	{
+		text.clear();
+		std::format_to(std::back_inserter(text), "@@ -{:08x},{} +{:08x},{} @@\n",
+					   address_of(old_begin), old_count, address_of(new_begin), new_count);
+		for (const auto word : std::span(old_words).subspan(old_begin, old_count))
+		{
+			text += '-';
+			dzl::format_word(word, text);
+		}
+		for (const auto word : std::span(new_words).subspan(new_begin, new_count))
+		{
+			text += '+';
+			dzl::format_word(word, text);
+		}
+		changed_word_count += std::max(old_count, new_count);
+		sink.write(text);
+	}
+	finish_output(t_options, sink);
+	std::println(std::cerr, "{} changes, {} words", changes.size(), changed_word_count);
+}
+
+auto run_build_index(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	const auto words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+	dzl::index::build_index(words, t_options.base, *t_options.index_path);
+}
+
+// Prints the address of every matching instruction
+auto run_query(const Options& t_options) -> void
+{
+	if (t_options.positional.empty())
+	{
+		throw std::invalid_argument("Expected at least one query term");
+	}
+
+	const dzl::index::InstructionIndex index(*t_options.query_path);
+	const auto matches{index.query(dzl::index::parse_query(t_options.positional))};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	for (const auto word_index : matches)
+	{
+		const auto address{index.base().get() +
+						   static_cast<dzl::Address::Underlying>(word_index * sizeof(dzl::Word))};
+		text.clear();
+		std::format_to(std::back_inserter(text), "{:08x}\n", address);
+		sink.write(text);
+	}
+	finish_output(t_options, sink);
+}
+
+// Reports where the time went, the busiest stage limiting the throughput
+auto run_pipeline(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	dzl::io::OutputSink sink;
+	const auto report{dzl::pipeline::run(t_options.positional[0], t_options.endianness, sink)};
+	finish_output(t_options, sink);
+
+	const auto milliseconds{[](const std::chrono::nanoseconds t_duration)
+							{ return std::chrono::duration<double, std::milli>(t_duration).count(); }};
+
+	std::println(std::cerr, "pipeline: {} words in {:.1f} ms", report.word_count,
+				 milliseconds(report.elapsed));
+	for (const auto& stage : report.stages)
+	{
+		std::println(std::cerr,
+					 "  {:<6}  busy {:>8.1f} ms  input wait {:>8.1f} ms  output wait {:>8.1f} ms",
+					 stage.name, milliseconds(stage.busy), milliseconds(stage.waiting_for_input),
+					 milliseconds(stage.waiting_for_output));
+	}
+	std::println(std::cerr, "  bottleneck: {}", report.bottleneck().name);
+}
+
+constexpr std::size_t output_slice_word_count{1UZ << 14U};
+
+auto run_file(const Options& t_options) -> void
+{
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	const auto words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	if (t_options.cache_directory)
+	{
+		dzl::cache::ResultCache cache(*t_options.cache_directory, t_options.cache_size);
+		dzl::cache::disassemble(words, t_options.base, cache, text);
+		sink.write(text);
+
+		const auto statistics{cache.statistics()};
+		std::println(std::cerr, "cache: {} hits, {} misses ({:.1f}% hit rate), {} evictions",
+					 statistics.hits, statistics.misses, 100.0 * statistics.hit_rate(),
+					 statistics.evictions);
+	}
+	else
+	{
+		// A slice at a time, so that the text stays cached, classified as a whole
+		const auto kinds{dzl::search::classify(words)};
+		for (std::size_t i_word{}; i_word < words.size(); i_word += output_slice_word_count)
+		{
+			const auto count{std::min(output_slice_word_count, words.size() - i_word)};
+
+			text.clear();
+			dzl::disassemble(std::span(words).subspan(i_word, count),
+							 std::span(kinds).subspan(i_word, count), text);
+			sink.write(text);
+		}
+	}
+	finish_output(t_options, sink);
+}
+
+// address:  word  instruction, with aligned columns
+auto run_listing(const Options& t_options) -> void
 {
-	if (t_argument_count <= 1)
+	if (t_options.positional.size() != 1)
+	{
+		throw std::invalid_argument("Expected a single image");
+	}
+
+	const auto words{dzl::io::load_image(t_options.positional[0], t_options.endianness)};
+	const auto symbols{t_options.symbols_path ? dzl::symbols::load_symbols(*t_options.symbols_path)
+											  : dzl::symbols::SymbolTable()};
+	const dzl::listing::Options listing_options{
+		.branch_targets = t_options.branch_targets,
+		.symbols = t_options.symbols_path ? &symbols : nullptr};
+
+	dzl::io::OutputSink sink;
+	std::string text;
+	const auto kinds{dzl::search::classify(words)};
+	for (std::size_t i_word{}; i_word < words.size(); i_word += output_slice_word_count)
 	{
-		// return 1;
+		const dzl::Address base(
+			static_cast<dzl::Address::Underlying>(t_options.base.get() + (4 * i_word)));
+		const auto count{std::min(output_slice_word_count, words.size() - i_word)};
+
+		text.clear();
+		dzl::listing::list(std::span(words).subspan(i_word, count),
+						   std::span(kinds).subspan(i_word, count), base, listing_options, text);
+		sink.write(text);
 	}
+	finish_output(t_options, sink);
+}
 
+// Keeps the images warm and answers requests until told to shut down
+auto run_serve(const Options& t_options) -> void
+{
+	if (t_options.positional.empty())
+	{
+		throw std::invalid_argument("Expected at least one image");
+	}
+
+	std::vector<dzl::server::ImageSource> images;
+	for (const auto path : t_options.positional)
+	{
+		images.push_back(
+			{.path = path, .base = t_options.base, .endianness = t_options.endianness});
+	}
+
+	dzl::server::Server server(images,
+							   {.socket_path = *t_options.socket_path,
+								.cache_size = static_cast<std::size_t>(t_options.cache_size)});
+	std::println(std::cerr, "serving {} images on {}", images.size(),
+				 t_options.socket_path->string());
+
+	server.run();
+	std::print(std::cerr, "{}", dzl::server::format_statistics(server.statistics()));
+}
+
+} // namespace
+
+auto main(const int t_argument_count, const char** t_arguments) -> int
+{
 	const std::span<const char* const> arguments(t_arguments,
 												 static_cast<std::size_t>(t_argument_count));
 
-	constexpr static dzl::ins::Instruction instruction{
-		dzl::ins::Multiply(dzl::ins::Operation::Multiply, dzl::Condition::Al, dzl::Register::R1,
-						   dzl::Register::R2, dzl::Register::R3, dzl::Register::R4, false, false,
-						   false, false)
-			.to_underlying()};
+	try
+	{
+		const auto options{parse_options(arguments)};
 
-	std::println("{}", instruction);
-}
\ No newline at end of file
+		if (options.batch)
+		{
+			run_batch(options);
+		}
+		else if (options.socket_path)
+		{
+			run_serve(options);
+		}
+		else if (options.query_path)
+		{
+			run_query(options);
+		}
+		else if (options.pipeline)
+		{
+			run_pipeline(options);
+		}
+		else if (options.diff)
+		{
+			run_diff(options);
+		}
+		else if (options.functions)
+		{
+			run_functions(options);
+		}
+		else if (options.index_path)
+		{
+			run_build_index(options);
+		}
+		else if (!options.search_patterns.empty())
+		{
+			run_search(options);
+		}
+		else if (options.listing || options.symbols_path)
+		{
+			run_listing(options);
+		}
+		else
+		{
+			run_file(options);
+		}
+	}
+	catch (const std::invalid_argument& error)
+	{
+		std::print(std::cerr, "{}\n{}", error.what(), usage);
+		return 1;
+	}
+	catch (const std::exception& error)
+	{
+		std::println(std::cerr, "{}", error.what());
+		return 1;
+	}
+}
@@ -0,0 +1,176 @@
+export module mnemonic_tables;
+
+import std;
+
+import types;
+import instruction;
+
+namespace dzl::mnemonic
+{
+/*
+	Condition suffixes, indexed by the raw 4-bit condition field
+*/
+constexpr std::size_t condition_count{16};
+constexpr std::array<std::string_view, condition_count> condition_names{
+	"eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc", "hi", "ls", "ge", "lt", "gt", "le", "", "nv"};
+
+export [[nodiscard]] constexpr auto condition_name(const Condition t_condition) noexcept
+{
+	return condition_names[static_cast<std::size_t>(t_condition)];
+}
+
+/*
+	Fixed-capacity mnemonic prefix (base, condition and flag suffixes)
+*/
+// Longest prefix is "umlaleqs"
+constexpr std::size_t max_prefix_size{8};
+
+class Prefix
+{
+public:
+	constexpr Prefix() = default;
+
+	consteval Prefix(const std::string_view t_base, const std::string_view t_condition,
+					 const std::string_view t_suffix)
+	{
+		append(t_base);
+		append(t_condition);
+		append(t_suffix);
+	}
+
+	[[nodiscard]] constexpr auto view() const noexcept
+	{
+		return std::string_view(m_text.data(), m_size);
+	}
+
+private:
+	consteval auto append(const std::string_view t_part) -> void
+	{
+		if (m_size + t_part.size() > m_text.size())
+		{
+			throw std::length_error("Mnemonic prefix too long");
+		}
+
+		std::ranges::copy(t_part, m_text.begin() + m_size);
+		m_size += static_cast<std::uint8_t>(t_part.size());
+	}
+
+	std::array<char, max_prefix_size> m_text{};
+	std::uint8_t m_size{};
+};
+
+/*
+	Table layouts
+
+	Without flags: [base][condition]
+	With flags: [base][condition][set condition codes]
+*/
+template <std::size_t base_count>
+consteval auto make_prefix_table(const std::array<std::string_view, base_count>& t_bases)
+{
+	std::array<Prefix, base_count * condition_count> table{};
+
+	for (std::size_t i_base{}; i_base < base_count; ++i_base)
+	{
+		for (std::size_t i_condition{}; i_condition < condition_count; ++i_condition)
+		{
+			table[(i_base * condition_count) + i_condition] =
+				Prefix(t_bases[i_base], condition_names[i_condition], "");
+		}
+	}
+
+	return table;
+}
+
+template <std::size_t base_count>
+consteval auto make_prefix_table(const std::array<std::string_view, base_count>& t_bases,
+								 const std::array<std::string_view, base_count>& t_flag_suffixes)
+{
+	std::array<Prefix, base_count * condition_count * 2> table{};
+
+	for (std::size_t i_base{}; i_base < base_count; ++i_base)
+	{
+		for (std::size_t i_condition{}; i_condition < condition_count; ++i_condition)
+		{
+			const auto index{((i_base * condition_count) + i_condition) * 2};
+			table[index] = Prefix(t_bases[i_base], condition_names[i_condition], "");
+			table[index + 1] =
+				Prefix(t_bases[i_base], condition_names[i_condition], t_flag_suffixes[i_base]);
+		}
+	}
+
+	return table;
+}
+
+// Data processing (comparisons always set the condition codes, so never take the suffix)
+constexpr auto data_processing_prefixes{make_prefix_table<16>(
+	{"and", "eor", "sub", "rsb", "add", "adc", "sbc", "rsc", //
+	 "tst", "teq", "cmp", "cmn", "orr", "mov", "bic", "mvn"},
+	{"s", "s", "s", "s", "s", "s", "s", "s", //
+	 "", "", "", "", "s", "s", "s", "s"})};
+
+// Multiply, indexed by [long][unsigned][accumulate]
+constexpr auto multiply_prefixes{make_prefix_table<6>(
+	{"mul", "mla", "smull", "smlal", "umull", "umlal"}, {"s", "s", "s", "s", "s", "s"})};
+
+// Branch, indexed by [link]
+constexpr auto branch_prefixes{make_prefix_table<2>({"b", "bl"})};
+
+constexpr auto branch_and_exchange_prefixes{make_prefix_table<1>({"bx"})};
+constexpr auto move_from_psr_prefixes{make_prefix_table<1>({"mrs"})};
+constexpr auto move_to_psr_prefixes{make_prefix_table<1>({"msr"})};
+
+/*
+	Lookups
+*/
+export [[nodiscard]] constexpr auto data_processing(const ins::DataProcessingOpCode t_op_code,
+													const Condition t_condition,
+													const bool t_set_condition_codes) noexcept
+{
+	const auto base{static_cast<std::size_t>(t_op_code)};
+	const auto condition{static_cast<std::size_t>(t_condition)};
+	const auto set_condition_codes{static_cast<std::size_t>(t_set_condition_codes)};
+
+	return data_processing_prefixes[(((base * condition_count) + condition) * 2) +
+									set_condition_codes]
+		.view();
+}
+
+export [[nodiscard]] constexpr auto multiply(const bool t_is_long, const bool t_is_unsigned,
+											 const bool t_accumulate, const Condition t_condition,
+											 const bool t_set_condition_codes) noexcept
+{
+	// "mul" and "mla" have no signedness
+	const auto long_base{t_is_long ? 2UZ + (2UZ * static_cast<std::size_t>(t_is_unsigned)) : 0UZ};
+	const auto base{long_base + static_cast<std::size_t>(t_accumulate)};
+	const auto condition{static_cast<std::size_t>(t_condition)};
+	const auto set_condition_codes{static_cast<std::size_t>(t_set_condition_codes)};
+
+	return multiply_prefixes[(((base * condition_count) + condition) * 2) + set_condition_codes]
+		.view();
+}
+
+export [[nodiscard]] constexpr auto branch(const bool t_link, const Condition t_condition) noexcept
+{
+	const auto base{static_cast<std::size_t>(t_link)};
+	const auto condition{static_cast<std::size_t>(t_condition)};
+
+	return branch_prefixes[(base * condition_count) + condition].view();
+}
+
+export [[nodiscard]] constexpr auto branch_and_exchange(const Condition t_condition) noexcept
+{
+	return branch_and_exchange_prefixes[static_cast<std::size_t>(t_condition)].view();
+}
+
+export [[nodiscard]] constexpr auto move_from_psr(const Condition t_condition) noexcept
+{
+	return move_from_psr_prefixes[static_cast<std::size_t>(t_condition)].view();
+}
+
+export [[nodiscard]] constexpr auto move_to_psr(const Condition t_condition) noexcept
+{
+	return move_to_psr_prefixes[static_cast<std::size_t>(t_condition)].view();
+}
+
+} // namespace dzl::mnemonic
@@ -0,0 +1,293 @@
+module;
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#else
+#include <stdio.h>
+#endif
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+export module output_sink;
+
+import std;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::io
+{
+export struct SinkStatistics
+{
+	std::size_t bytes;
+	std::size_t lines;
+	std::chrono::nanoseconds elapsed;
+
+	[[nodiscard]] auto lines_per_second() const noexcept
+	{
+		const std::chrono::duration<double> seconds(elapsed);
+		return seconds.count() > 0.0 ? static_cast<double>(lines) / seconds.count() : 0.0;
+	}
+};
+
+/*
+	Buffers are whole pages, written flush_batch_count at a time
+*/
+export constexpr int standard_output{1};
+
+constexpr std::size_t page_size{4096};
+constexpr std::size_t buffer_size{256UZ * 1024UZ};
+constexpr std::size_t flush_batch_count{4};
+
+struct PageDelete
+{
+	auto operator()(char* const t_pointer) const noexcept -> void
+	{
+		::operator delete[](t_pointer, std::align_val_t(page_size));
+	}
+};
+
+using Buffer = std::unique_ptr<char[], PageDelete>;
+
+[[nodiscard]] auto make_buffer()
+{
+	return Buffer(static_cast<char*>(::operator new[](buffer_size, std::align_val_t(page_size))));
+}
+
+/*
+	Accumulates text in large page-aligned buffers and writes several buffers per system call:
+	vmsplice when standard output is a pipe on Linux, writev elsewhere on POSIX systems and fwrite
+	otherwise.
+
+	vmsplice hands the pages themselves to the pipe, so a buffer may only be refilled once the
+	reader consumed it. Only full buffers are spliced, and the ring of buffers is made larger than
+	the pipe: refilling a buffer happens only after more than a pipe's worth of later data was
+	spliced. A partly filled buffer is copied on flush instead and refilled in place, as the pipe
+	counts its capacity in pages whatever they hold.
+*/
+export class OutputSink
+{
+public:
+	// Writes to the file descriptor t_descriptor on POSIX systems, which the caller keeps open
+	explicit OutputSink(const int t_descriptor = standard_output)
+		: m_descriptor(t_descriptor), m_start(std::chrono::steady_clock::now())
+	{
+		auto buffer_count{flush_batch_count};
+
+#if defined(__linux__)
+		struct stat status{};
+		if (::fstat(m_descriptor, &status) == 0 && S_ISFIFO(status.st_mode))
+		{
+			// A larger pipe means fewer context switches with the reader, if permitted
+			::fcntl(m_descriptor, F_SETPIPE_SZ, 1 << 20);
+
+			const auto pipe_size{::fcntl(m_descriptor, F_GETPIPE_SZ)};
+			if (pipe_size > 0)
+			{
+				m_splice = true;
+				buffer_count += ((static_cast<std::size_t>(pipe_size) + buffer_size - 1) /
+								 buffer_size) +
+								1;
+			}
+		}
+#endif
+
+		m_buffers.reserve(buffer_count);
+		for (std::size_t i_buffer{}; i_buffer < buffer_count; ++i_buffer)
+		{
+			m_buffers.push_back(make_buffer());
+		}
+	}
+
+	OutputSink(const OutputSink&) = delete;
+	OutputSink(OutputSink&&) = delete;
+	auto operator=(const OutputSink&) -> OutputSink& = delete;
+	auto operator=(OutputSink&&) -> OutputSink& = delete;
+
+	// Errors cannot be reported from here, flush() first to see them
+	~OutputSink()
+	{
+		try
+		{
+			flush();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	auto write(std::string_view t_text) -> void
+	{
+		m_statistics.bytes += t_text.size();
+		m_statistics.lines += static_cast<std::size_t>(std::ranges::count(t_text, '\n'));
+
+		while (!t_text.empty())
+		{
+			const auto size{std::min(t_text.size(), buffer_size - m_used)};
+			std::ranges::copy(t_text.substr(0, size), m_buffers[m_current].get() + m_used);
+			m_used += size;
+			t_text.remove_prefix(size);
+
+			if (m_used == buffer_size)
+			{
+				if (pending_count() == flush_batch_count)
+				{
+					write_pending();
+				}
+				else
+				{
+					advance();
+				}
+			}
+		}
+	}
+
+	auto flush() -> void
+	{
+		// Full buffers may be pending behind an empty current one
+		if (m_used != 0 || m_current != m_first_pending)
+		{
+			write_pending();
+		}
+		m_statistics.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - m_start);
+	}
+
+	[[nodiscard]] auto statistics() const noexcept { return m_statistics; }
+
+private:
+	[[nodiscard]] auto pending_count() const noexcept
+	{
+		return ((m_current + m_buffers.size() - m_first_pending) % m_buffers.size()) + 1;
+	}
+
+	auto advance() noexcept -> void
+	{
+		m_current = (m_current + 1) % m_buffers.size();
+		m_used = 0;
+	}
+
+	/*
+		Writes the buffers from m_first_pending to m_current. A full current buffer is left for a
+		fresh one, a partly filled one is copied and refilled.
+	*/
+	auto write_pending() -> void
+	{
+		const auto current_full{m_used == buffer_size};
+		const auto copy_current{!current_full && m_used != 0 && m_splice};
+
+		std::array<std::span<const char>, flush_batch_count> pending;
+		std::size_t count{};
+		for (std::size_t i_pending{}; i_pending + 1 < pending_count(); ++i_pending)
+		{
+			const auto index{(m_first_pending + i_pending) % m_buffers.size()};
+			pending[count++] = std::span<const char>(m_buffers[index].get(), buffer_size);
+		}
+
+		const std::span current(m_buffers[m_current].get(), m_used);
+		if (current_full || (m_used != 0 && !copy_current))
+		{
+			pending[count++] = current;
+		}
+		write_all(std::span(pending).first(count), m_splice);
+
+		if (current_full)
+		{
+			advance();
+		}
+		else
+		{
+			if (copy_current)
+			{
+				write_all(std::array{std::span<const char>(current)}, false);
+			}
+			m_used = 0;
+		}
+		m_first_pending = m_current;
+	}
+
+	// Splices when t_splice is set and the output allows it
+	auto write_all(const std::span<const std::span<const char>> t_pending,
+				   [[maybe_unused]] const bool t_splice) -> void
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		std::array<::iovec, flush_batch_count> vectors{};
+		for (std::size_t i_pending{}; i_pending < t_pending.size(); ++i_pending)
+		{
+			vectors[i_pending] = {.iov_base = const_cast<char*>(t_pending[i_pending].data()),
+								  .iov_len = t_pending[i_pending].size()};
+		}
+
+		auto remaining{std::span(vectors).first(t_pending.size())};
+		while (!remaining.empty())
+		{
+			const auto vector_count{static_cast<int>(remaining.size())};
+#if defined(__linux__)
+			const auto splice{m_splice && t_splice};
+			const auto written{splice ? ::vmsplice(m_descriptor, remaining.data(),
+												   static_cast<unsigned long>(vector_count), 0)
+									  : ::writev(m_descriptor, remaining.data(), vector_count)};
+
+			// Not every pipe accepts spliced pages
+			if (written < 0 && splice && (errno == EINVAL || errno == ENOSYS))
+			{
+				m_splice = false;
+				continue;
+			}
+#else
+			const auto written{::writev(m_descriptor, remaining.data(), vector_count)};
+#endif
+			if (written < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::runtime_error("Cannot write the output");
+			}
+
+			// Skip what was written, partially written vectors are advanced in place
+			auto skipped{static_cast<std::size_t>(written)};
+			while (!remaining.empty() && skipped >= remaining.front().iov_len)
+			{
+				skipped -= remaining.front().iov_len;
+				remaining = remaining.subspan(1);
+			}
+			if (!remaining.empty())
+			{
+				remaining.front().iov_base = static_cast<char*>(remaining.front().iov_base) + skipped;
+				remaining.front().iov_len -= skipped;
+			}
+		}
+#else
+		for (const auto text : t_pending)
+		{
+			if (std::fwrite(text.data(), 1, text.size(), stdout) != text.size())
+			{
+				throw std::runtime_error("Cannot write the output");
+			}
+		}
+		std::fflush(stdout);
+#endif
+	}
+
+	int m_descriptor;
+
+	std::vector<Buffer> m_buffers;
+	std::size_t m_current{};
+	std::size_t m_used{};
+	std::size_t m_first_pending{};
+
+	bool m_splice{};
+
+	std::chrono::steady_clock::time_point m_start;
+	SinkStatistics m_statistics{};
+};
+
+} // namespace dzl::io
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,406 @@
+export module paged_view;
+
+import std;
+
+import unsigned_integer;
+import mapped_file;
+import lru_cache;
+
+import types;
+import instruction;
+import image;
+import data_classifier;
+import disassembly;
+import listing;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::views
+{
+/*
+	The text of a run of consecutive words, one line each
+*/
+export struct FormattedPage
+{
+	std::string text;
+
+	// End of each word's line in text
+	std::vector<std::uint32_t> line_ends;
+
+	[[nodiscard]] auto line_count() const noexcept { return line_ends.size(); }
+
+	// Lines t_first to t_first + t_count, newlines included
+	[[nodiscard]] auto lines(const std::size_t t_first, const std::size_t t_count) const noexcept
+	{
+		const auto begin{t_first == 0 ? 0 : line_ends[t_first - 1]};
+		const auto end{line_ends[t_first + t_count - 1]};
+		return std::string_view(text).substr(begin, end - begin);
+	}
+};
+
+// Listing lines with t_listing, the default output without. Data words have no instruction.
+export [[nodiscard]] auto format_page(const std::span<const Word> t_words,
+									  const std::span<const std::optional<ins::Instruction>>
+										  t_instructions,
+									  const Address t_base,
+									  const std::optional<listing::Options>& t_listing)
+	-> FormattedPage
+{
+	FormattedPage page;
+	page.line_ends.reserve(t_words.size());
+
+	for (std::size_t i_word{}; i_word < t_words.size(); ++i_word)
+	{
+		if (t_listing)
+		{
+			const auto address{
+				t_base + AddressOffset(static_cast<AddressOffset::Underlying>(4 * i_word))};
+			listing::append_line(address, t_words[i_word], t_instructions[i_word], *t_listing,
+								 page.text);
+		}
+		else
+		{
+			format_decoded(t_instructions[i_word], t_words[i_word], page.text);
+		}
+		page.line_ends.push_back(static_cast<std::uint32_t>(page.text.size()));
+	}
+	return page;
+}
+
+// Words of a foreign byte order swapped at once while classifying, a multiple of the window
+constexpr std::size_t classify_block_word_count{64UZ * 1024UZ};
+
+export struct PagedViewOptions
+{
+	std::size_t page_word_count{4096};
+
+	// Formatted text kept in memory, in bytes
+	std::size_t cache_size{64UZ << 20U};
+
+	// Formats the pages either side of the last one accessed on a background thread
+	bool prefetch{true};
+
+	// Listing lines with these options, the default output without
+	std::optional<listing::Options> listing;
+};
+
+export struct PageStatistics
+{
+	std::size_t hits;
+	std::size_t misses;
+	std::size_t evictions;
+	std::size_t prefetched;
+};
+
+/*
+	Random access to the text of an image of any size, a page at a time. Pages are decoded and
+	formatted on first access and kept in a least recently used cache, so that scrolling and
+	jumping cost the same whatever the image size.
+
+	Words are classified as code or data once over the whole image, so a literal loaded from
+	another page is data like any other.
+*/
+export class PagedView
+{
+public:
+	PagedView(const std::filesystem::path& t_path, const Address t_base,
+			  const std::endian t_endianness, PagedViewOptions t_options = {})
+		: m_file(std::in_place, t_path), m_base(t_base), m_endianness(t_endianness),
+		  m_options(std::move(t_options)), m_cache(m_options.cache_size)
+	{
+		const auto bytes{m_file->bytes()};
+
+		// Mappings are page aligned, so words are read in place
+		m_words = std::span(reinterpret_cast<const Word*>(bytes.data()), bytes.size() / sizeof(Word));
+		start();
+	}
+
+	// Words in host byte order, which must outlive the view
+	PagedView(const std::span<const Word> t_words, const Address t_base,
+			  PagedViewOptions t_options = {})
+		: m_words(t_words), m_base(t_base), m_options(std::move(t_options)),
+		  m_cache(m_options.cache_size)
+	{
+		start();
+	}
+
+	PagedView(const PagedView&) = delete;
+	PagedView(PagedView&&) = delete;
+	auto operator=(const PagedView&) -> PagedView& = delete;
+	auto operator=(PagedView&&) -> PagedView& = delete;
+	~PagedView() = default;
+
+	[[nodiscard]] auto base() const noexcept { return m_base; }
+	[[nodiscard]] auto word_count() const noexcept { return m_words.size(); }
+	[[nodiscard]] auto page_word_count() const noexcept { return m_options.page_word_count; }
+	[[nodiscard]] auto page_count() const noexcept
+	{
+		return (m_words.size() + m_options.page_word_count - 1) / m_options.page_word_count;
+	}
+
+	// Index of the word at t_address, if inside the image
+	[[nodiscard]] auto word_index(const Address t_address) const noexcept
+		-> std::optional<std::size_t>
+	{
+		return io::word_index(m_base, t_address, m_words.size());
+	}
+
+	[[nodiscard]] auto page(const std::size_t t_index) -> std::shared_ptr<const FormattedPage>
+	{
+		if (t_index >= page_count())
+		{
+			throw std::out_of_range(std::format("No page {} in {} pages", t_index, page_count()));
+		}
+
+		std::unique_lock lock(m_mutex);
+		auto page{m_cache.find(t_index)};
+		if (page)
+		{
+			++m_statistics.hits;
+		}
+		else
+		{
+			++m_statistics.misses;
+
+			// A page being prefetched is waited for rather than formatted twice
+			m_page_ready.wait(lock, [&] { return !m_in_flight.contains(t_index); });
+			page = m_cache.find(t_index);
+			if (!page)
+			{
+				m_in_flight.insert(t_index);
+				lock.unlock();
+				try
+				{
+					page = format(t_index);
+				}
+				catch (...)
+				{
+					lock.lock();
+					m_in_flight.erase(t_index);
+					m_page_ready.notify_all();
+					throw;
+				}
+				lock.lock();
+				store(t_index, page);
+			}
+		}
+
+		schedule_neighbours(t_index);
+		return page;
+	}
+
+	// Lines of t_count words from t_address on, cut short by the end of the image
+	[[nodiscard]] auto lines(const Address t_address, const std::size_t t_count) -> std::string
+	{
+		const auto first{word_index(t_address)};
+		if (!first)
+		{
+			throw std::out_of_range(
+				std::format("Address {:#010x} outside the image", t_address.get()));
+		}
+
+		const auto end{std::min(*first + t_count, m_words.size())};
+		const auto page_words{m_options.page_word_count};
+
+		std::string text;
+		for (auto i_word{*first}; i_word < end;)
+		{
+			const auto page_index{i_word / page_words};
+			const auto page_first{page_index * page_words};
+			const auto count{std::min(end, page_first + page_words) - i_word};
+
+			text.append(page(page_index)->lines(i_word - page_first, count));
+			i_word += count;
+		}
+		return text;
+	}
+
+	[[nodiscard]] auto statistics() const -> PageStatistics
+	{
+		const std::scoped_lock lock(m_mutex);
+		return m_statistics;
+	}
+
+	// Blocks until the background thread has nothing left to prefetch
+	auto wait_for_prefetch() -> void
+	{
+		std::unique_lock lock(m_mutex);
+		m_page_ready.wait(lock, [&] { return m_prefetch_queue.empty() && m_in_flight.empty(); });
+	}
+
+private:
+	auto start() -> void
+	{
+		if (m_options.page_word_count == 0)
+		{
+			throw std::invalid_argument("Pages must hold at least one word");
+		}
+		classify_image();
+
+		if (m_options.prefetch)
+		{
+			m_prefetcher = std::jthread([this](const std::stop_token t_stop_token)
+										{ prefetch(t_stop_token); });
+		}
+	}
+
+	// Swapped a block at a time when the image needs it, rather than copied whole
+	auto classify_image() -> void
+	{
+		if (m_endianness == std::endian::native)
+		{
+			m_kinds = search::classify(m_words);
+			return;
+		}
+
+		search::StreamingClassifier classifier;
+		std::vector<Word> block;
+		m_kinds.reserve(m_words.size());
+
+		for (std::size_t i_word{}; i_word < m_words.size(); i_word += classify_block_word_count)
+		{
+			const auto words{m_words.subspan(
+				i_word, std::min(classify_block_word_count, m_words.size() - i_word))};
+			block.assign(words.begin(), words.end());
+			io::to_native(block, m_endianness);
+			classifier.push(block);
+			take_final(classifier);
+		}
+		classifier.finish();
+		take_final(classifier);
+	}
+
+	// Moves the kinds that became final out of t_classifier
+	auto take_final(search::StreamingClassifier& t_classifier) -> void
+	{
+		const auto kinds{t_classifier.kinds(m_kinds.size(),
+											t_classifier.final_count() - m_kinds.size())};
+		m_kinds.insert(m_kinds.end(), kinds.begin(), kinds.end());
+		t_classifier.release(m_kinds.size());
+	}
+
+	[[nodiscard]] auto format(const std::size_t t_index) const
+		-> std::shared_ptr<const FormattedPage>
+	{
+		const auto first{t_index * m_options.page_word_count};
+		auto words{m_words.subspan(first, std::min(m_options.page_word_count,
+												   m_words.size() - first))};
+
+		// Only the page is swapped, never the whole image
+		std::vector<Word> swapped;
+		if (m_endianness != std::endian::native)
+		{
+			swapped.assign(words.begin(), words.end());
+			io::to_native(swapped, m_endianness);
+			words = swapped;
+		}
+
+		std::vector<std::optional<ins::Instruction>> instructions;
+		decode_classified(words, std::span(m_kinds).subspan(first, words.size()), instructions);
+
+		const auto base{
+			m_base + AddressOffset(static_cast<AddressOffset::Underlying>(4 * first))};
+		return std::make_shared<const FormattedPage>(
+			format_page(words, instructions, base, m_options.listing));
+	}
+
+	// With the lock held
+	auto store(const std::size_t t_index, std::shared_ptr<const FormattedPage> t_page) -> void
+	{
+		m_in_flight.erase(t_index);
+		const auto size{t_page->text.size()};
+		m_statistics.evictions += m_cache.insert(t_index, std::move(t_page), size);
+		m_page_ready.notify_all();
+	}
+
+	// With the lock held. Only the neighbours of the latest access are worth formatting.
+	auto schedule_neighbours(const std::size_t t_index) -> void
+	{
+		if (!m_options.prefetch)
+		{
+			return;
+		}
+
+		m_prefetch_queue.clear();
+		for (const auto neighbour : {t_index + 1, t_index - 1})
+		{
+			if (neighbour < page_count() && !m_cache.contains(neighbour) &&
+				!m_in_flight.contains(neighbour))
+			{
+				m_prefetch_queue.push_back(neighbour);
+			}
+		}
+
+		if (!m_prefetch_queue.empty())
+		{
+			m_prefetch_available.notify_one();
+		}
+	}
+
+	auto prefetch(const std::stop_token t_stop_token) -> void
+	{
+		std::unique_lock lock(m_mutex);
+		while (m_prefetch_available.wait(lock, t_stop_token,
+										 [this] { return !m_prefetch_queue.empty(); }))
+		{
+			const auto index{m_prefetch_queue.front()};
+			m_prefetch_queue.pop_front();
+
+			if (!m_cache.contains(index) && !m_in_flight.contains(index))
+			{
+				m_in_flight.insert(index);
+				lock.unlock();
+				std::shared_ptr<const FormattedPage> page;
+				try
+				{
+					page = format(index);
+				}
+				catch (...)
+				{
+					// Dropped, a later access formats it again and sees the error
+				}
+				lock.lock();
+
+				if (page)
+				{
+					store(index, std::move(page));
+					++m_statistics.prefetched;
+				}
+				else
+				{
+					m_in_flight.erase(index);
+					m_page_ready.notify_all();
+				}
+			}
+			else
+			{
+				m_page_ready.notify_all();
+			}
+		}
+	}
+
+	std::optional<MappedFile> m_file;
+	std::span<const Word> m_words;
+	Address m_base;
+	std::endian m_endianness{std::endian::native};
+	PagedViewOptions m_options;
+
+	// Of the whole image, so that a page's text does not depend on the page size
+	std::vector<search::WordKind> m_kinds;
+
+	mutable std::mutex m_mutex;
+	LruCache<std::size_t, FormattedPage> m_cache;
+	std::unordered_set<std::size_t> m_in_flight;
+	std::deque<std::size_t> m_prefetch_queue;
+	PageStatistics m_statistics{};
+
+	std::condition_variable m_page_ready;
+	std::condition_variable_any m_prefetch_available;
+
+	// Last, so that it stops before anything it uses goes away
+	std::jthread m_prefetcher;
+};
+
+} // namespace dzl::views
+
+// NOLINTEND(*-magic-numbers)
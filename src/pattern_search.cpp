@@ -0,0 +1,225 @@
+module;
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+export module pattern_search;
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import arm_instruction;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::search
+{
+using fmt::arm::FormatMask;
+
+export struct Match
+{
+	std::size_t index;
+	std::size_t pattern;
+};
+
+/*
+	Named patterns, any condition
+*/
+struct NamedPattern
+{
+	std::string_view name;
+	std::span<const FormatMask> masks;
+};
+
+constexpr std::array branch_masks{
+	FormatMask{.checked_bits = 0x0F00'0000_u32, .required_bits = 0x0A00'0000_u32}};
+constexpr std::array branch_with_link_masks{
+	FormatMask{.checked_bits = 0x0F00'0000_u32, .required_bits = 0x0B00'0000_u32}};
+constexpr std::array branch_and_exchange_lr_masks{
+	FormatMask{.checked_bits = 0x0FFF'FFFF_u32, .required_bits = 0x012F'FF1E_u32}};
+constexpr std::array software_interrupt_masks{
+	FormatMask{.checked_bits = 0x0F00'0000_u32, .required_bits = 0x0F00'0000_u32}};
+/*
+	Data processing with pc as the destination leaves out tst, teq, cmp and cmn (opcodes 8 to 11),
+	which share their encoding space with bx and the status register moves, and the register
+	forms with bits 7 and 4 set, which are multiplies and halfword transfers. The masks are
+	disjoint, so a word is reported once.
+*/
+constexpr std::array pc_write_masks{
+	// Opcodes 0 to 7 and 12 to 15 with an immediate
+	FormatMask{.checked_bits = 0x0F00'F000_u32, .required_bits = 0x0200'F000_u32},
+	FormatMask{.checked_bits = 0x0F80'F000_u32, .required_bits = 0x0380'F000_u32},
+	// Shifted by an immediate
+	FormatMask{.checked_bits = 0x0F00'F010_u32, .required_bits = 0x0000'F000_u32},
+	FormatMask{.checked_bits = 0x0F80'F010_u32, .required_bits = 0x0180'F000_u32},
+	// Shifted by a register
+	FormatMask{.checked_bits = 0x0F00'F090_u32, .required_bits = 0x0000'F010_u32},
+	FormatMask{.checked_bits = 0x0F80'F090_u32, .required_bits = 0x0180'F010_u32},
+	// Load into pc
+	FormatMask{.checked_bits = 0x0C10'F000_u32, .required_bits = 0x0410'F000_u32},
+	// Load multiple including pc
+	FormatMask{.checked_bits = 0x0E10'8000_u32, .required_bits = 0x0810'8000_u32}};
+
+constexpr std::array named_patterns{
+	NamedPattern{.name = "b", .masks = branch_masks},
+	NamedPattern{.name = "bl", .masks = branch_with_link_masks},
+	NamedPattern{.name = "bx-lr", .masks = branch_and_exchange_lr_masks},
+	NamedPattern{.name = "swi", .masks = software_interrupt_masks},
+	NamedPattern{.name = "pc-write", .masks = pc_write_masks}};
+
+/*
+	Accepts either a named pattern or "<checked bits>:<required bits>" in hexadecimal
+*/
+export [[nodiscard]] auto parse_pattern(const std::string_view t_text) -> std::vector<FormatMask>
+{
+	const auto named{std::ranges::find(named_patterns, t_text, &NamedPattern::name)};
+	if (named != named_patterns.end())
+	{
+		return std::vector<FormatMask>(named->masks.begin(), named->masks.end());
+	}
+
+	const auto parse_hexadecimal{[&](std::string_view t_digits)
+								 {
+									 if (t_digits.starts_with("0x") || t_digits.starts_with("0X"))
+									 {
+										 t_digits.remove_prefix(2);
+									 }
+
+									 Word::Underlying value{};
+									 const auto [end, error]{
+										 std::from_chars(t_digits.data(),
+														 t_digits.data() + t_digits.size(),
+														 value, 16)};
+									 if (error != std::errc() || t_digits.empty() ||
+										 end != t_digits.data() + t_digits.size())
+									 {
+										 throw std::invalid_argument(
+											 std::format("Invalid pattern: {}", t_text));
+									 }
+									 return Word(value);
+								 }};
+
+	const auto separator{t_text.find(':')};
+	if (separator == std::string_view::npos)
+	{
+		throw std::invalid_argument(std::format("Invalid pattern: {}", t_text));
+	}
+
+	const auto checked_bits{parse_hexadecimal(t_text.substr(0, separator))};
+	const auto required_bits{parse_hexadecimal(t_text.substr(separator + 1))};
+	if ((required_bits & ~checked_bits) != 0_u32)
+	{
+		throw std::invalid_argument(
+			std::format("Pattern requires bits that it does not check: {}", t_text));
+	}
+
+	return {FormatMask{.checked_bits = checked_bits, .required_bits = required_bits}};
+}
+
+/*
+	Matching, 8 words per block
+*/
+constexpr std::size_t block_word_count{8};
+
+// Bit i is set when word i of the block matches
+[[nodiscard]] auto match_block(const Word* const t_words, const FormatMask t_pattern) noexcept
+	-> unsigned
+{
+#if defined(__AVX2__)
+	const auto checked{_mm256_set1_epi32(static_cast<int>(t_pattern.checked_bits.get()))};
+	const auto required{_mm256_set1_epi32(static_cast<int>(t_pattern.required_bits.get()))};
+
+	const auto words{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_words))};
+	const auto equal{_mm256_cmpeq_epi32(_mm256_and_si256(words, checked), required)};
+	return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+#elif defined(__SSE2__)
+	const auto checked{_mm_set1_epi32(static_cast<int>(t_pattern.checked_bits.get()))};
+	const auto required{_mm_set1_epi32(static_cast<int>(t_pattern.required_bits.get()))};
+
+	const auto low{_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_words))};
+	const auto high{_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_words + 4))};
+	const auto low_equal{_mm_cmpeq_epi32(_mm_and_si128(low, checked), required)};
+	const auto high_equal{_mm_cmpeq_epi32(_mm_and_si128(high, checked), required)};
+	return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(low_equal))) |
+		   (static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(high_equal))) << 4U);
+#else
+	unsigned mask{};
+	for (std::size_t i_word{}; i_word < block_word_count; ++i_word)
+	{
+		const auto matches{(t_words[i_word] & t_pattern.checked_bits) == t_pattern.required_bits};
+		mask |= static_cast<unsigned>(matches) << i_word;
+	}
+	return mask;
+#endif
+}
+
+/*
+	Finds every word matching any of the patterns, in word order. A word matching several
+	patterns is reported once per pattern.
+*/
+export [[nodiscard]] auto find_matches(const std::span<const Word> t_words,
+									   const std::span<const FormatMask> t_patterns)
+{
+	std::vector<Match> matches;
+	std::vector<unsigned> pattern_masks(t_patterns.size());
+
+	const auto report{[&](const std::size_t t_first_word, const unsigned t_any_mask)
+					  {
+						  for (auto remaining{t_any_mask}; remaining != 0U;
+							   remaining &= remaining - 1U)
+						  {
+							  const auto bit{static_cast<unsigned>(std::countr_zero(remaining))};
+							  for (std::size_t i_pattern{}; i_pattern < t_patterns.size();
+								   ++i_pattern)
+							  {
+								  if (((pattern_masks[i_pattern] >> bit) & 1U) != 0U)
+								  {
+									  matches.push_back({t_first_word + bit, i_pattern});
+								  }
+							  }
+						  }
+					  }};
+
+	std::size_t i_word{};
+	for (; i_word + block_word_count <= t_words.size(); i_word += block_word_count)
+	{
+		unsigned any_mask{};
+		for (std::size_t i_pattern{}; i_pattern < t_patterns.size(); ++i_pattern)
+		{
+			pattern_masks[i_pattern] = match_block(t_words.data() + i_word, t_patterns[i_pattern]);
+			any_mask |= pattern_masks[i_pattern];
+		}
+
+		// Matches are rare, so the common case is a single test per block
+		if (any_mask != 0U)
+		{
+			report(i_word, any_mask);
+		}
+	}
+
+	// Tail, with the padding words masked out
+	if (i_word < t_words.size())
+	{
+		std::array<Word, block_word_count> tail{};
+		std::ranges::copy(t_words.subspan(i_word), tail.begin());
+
+		const auto valid_mask{(1U << (t_words.size() - i_word)) - 1U};
+		unsigned any_mask{};
+		for (std::size_t i_pattern{}; i_pattern < t_patterns.size(); ++i_pattern)
+		{
+			pattern_masks[i_pattern] = match_block(tail.data(), t_patterns[i_pattern]) & valid_mask;
+			any_mask |= pattern_masks[i_pattern];
+		}
+
+		report(i_word, any_mask);
+	}
+
+	return matches;
+}
+
+} // namespace dzl::search
+
+// NOLINTEND(*-magic-numbers)
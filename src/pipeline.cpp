@@ -0,0 +1,345 @@
+export module pipeline;
+
+import std;
+
+import unsigned_integer;
+import spsc_queue;
+import text_arena;
+
+import types;
+import instruction;
+import image;
+import data_classifier;
+import disassembly;
+import output_sink;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::pipeline
+{
+/*
+	Statistics
+
+	A stage that rarely waits for input is the bottleneck, and the stages before it wait for
+	output (backpressure).
+*/
+export struct StageStatistics
+{
+	std::string_view name;
+	std::chrono::nanoseconds busy;
+	std::chrono::nanoseconds waiting_for_input;
+	std::chrono::nanoseconds waiting_for_output;
+};
+
+export struct Report
+{
+	std::size_t word_count;
+	std::chrono::nanoseconds elapsed;
+	std::array<StageStatistics, 4> stages;
+
+	[[nodiscard]] auto bottleneck() const -> const StageStatistics&
+	{
+		return *std::ranges::max_element(stages, std::ranges::less(), &StageStatistics::busy);
+	}
+};
+
+/*
+	Chunks circulate reader -> decoder -> formatter -> writer and back to the reader, their
+	buffers keeping their capacity between uses. Each chunk's text arena is only touched by the
+	stage holding the chunk, and is reset once the writer has flushed it.
+*/
+constexpr std::size_t chunk_word_count{1UZ << 16U};
+constexpr std::size_t chunk_count{8};
+constexpr std::size_t stage_queue_capacity{2};
+// Formatted lines average well under 32 bytes
+constexpr std::size_t text_block_size{chunk_word_count * 32};
+
+struct Chunk
+{
+	// Index of the first word in the image
+	std::size_t first_word{};
+	std::vector<Word> words;
+	std::vector<std::optional<ins::Instruction>> instructions;
+	TextArena text{text_block_size};
+};
+
+// Null marks the end of the stream
+using StageQueue = SpscQueue<Chunk*, stage_queue_capacity>;
+// Room for every chunk and the writer's end marker
+using FreeQueue = SpscQueue<Chunk*, chunk_count + 1>;
+
+// First exception of any stage, after which the remaining chunks only pass through
+class Failure
+{
+public:
+	auto set(std::exception_ptr t_exception) -> void
+	{
+		const std::scoped_lock lock(m_mutex);
+		if (!m_exception)
+		{
+			m_exception = std::move(t_exception);
+		}
+		m_failed.store(true, std::memory_order::relaxed);
+	}
+
+	[[nodiscard]] auto failed() const noexcept { return m_failed.load(std::memory_order::relaxed); }
+
+	auto rethrow() -> void
+	{
+		if (m_exception)
+		{
+			std::rethrow_exception(m_exception);
+		}
+	}
+
+private:
+	std::mutex m_mutex;
+	std::exception_ptr m_exception;
+	std::atomic<bool> m_failed;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Adds the time taken by t_function to t_total
+auto timed(std::chrono::nanoseconds& t_total, const std::invocable auto& t_function)
+{
+	const auto start{Clock::now()};
+	const auto finish{[&]
+					  {
+						  t_total += std::chrono::duration_cast<std::chrono::nanoseconds>(
+							  Clock::now() - start);
+					  }};
+
+	if constexpr (std::is_void_v<std::invoke_result_t<decltype(t_function)>>)
+	{
+		t_function();
+		finish();
+	}
+	else
+	{
+		auto result{t_function()};
+		finish();
+		return result;
+	}
+}
+
+template <typename InputQueue, typename OutputQueue>
+auto run_stage(InputQueue& t_input, OutputQueue& t_output, StageStatistics& t_statistics,
+			   Failure& t_failure, const std::invocable<Chunk&> auto& t_process) -> void
+{
+	while (true)
+	{
+		auto* const chunk{timed(t_statistics.waiting_for_input, [&] { return t_input.pop(); })};
+		if (chunk != nullptr && !t_failure.failed())
+		{
+			try
+			{
+				timed(t_statistics.busy, [&] { t_process(*chunk); });
+			}
+			catch (...)
+			{
+				t_failure.set(std::current_exception());
+			}
+		}
+
+		timed(t_statistics.waiting_for_output, [&] { t_output.push(chunk); });
+		if (chunk == nullptr)
+		{
+			return;
+		}
+	}
+}
+
+/*
+	Disassembles an image to t_output with dedicated reader, decoder, formatter and writer threads
+*/
+export auto run(const std::filesystem::path& t_path, const std::endian t_endianness,
+				io::OutputSink& t_output) -> Report
+{
+	std::ifstream file(t_path, std::ios::binary);
+	if (!file)
+	{
+		throw std::runtime_error(std::format("Cannot open {}", t_path.string()));
+	}
+
+	std::vector<Chunk> chunks(chunk_count);
+	FreeQueue free_chunks;
+	for (auto& chunk : chunks)
+	{
+		free_chunks.push(&chunk);
+	}
+
+	StageQueue read_chunks;
+	StageQueue decoded_chunks;
+	StageQueue formatted_chunks;
+
+	Report report{
+		.word_count = 0,
+		.elapsed = {},
+		.stages = {{{.name = "read"}, {.name = "decode"}, {.name = "format"}, {.name = "write"}}}};
+	auto& [reader, decoder, formatter, writer]{report.stages};
+
+	Failure failure;
+	const auto start{Clock::now()};
+	{
+		// Stops at the end of the file, or as soon as any stage failed
+		const std::jthread reader_thread(
+			[&]
+			{
+				while (!failure.failed())
+				{
+					auto* const chunk{
+						timed(reader.waiting_for_input, [&] { return free_chunks.pop(); })};
+
+					try
+					{
+						const auto word_count{timed(
+							reader.busy,
+							[&]
+							{
+								chunk->words.resize(chunk_word_count);
+								file.read(reinterpret_cast<char*>(chunk->words.data()),
+										  static_cast<std::streamsize>(chunk_word_count *
+																	   sizeof(Word)));
+
+								const auto read_words{static_cast<std::size_t>(file.gcount()) /
+													  sizeof(Word)};
+								chunk->words.resize(read_words);
+								io::to_native(chunk->words, t_endianness);
+								return read_words;
+							})};
+
+						if (word_count == 0)
+						{
+							break;
+						}
+						chunk->first_word = report.word_count;
+						report.word_count += word_count;
+					}
+					catch (...)
+					{
+						failure.set(std::current_exception());
+						break;
+					}
+
+					timed(reader.waiting_for_output, [&] { read_chunks.push(chunk); });
+				}
+
+				read_chunks.push(nullptr);
+			});
+
+		/*
+			Words classified as data are never decoded. The image is classified as a whole, so
+			a chunk waits until loads at the start of the next one can no longer mark its words.
+		*/
+		const std::jthread decoder_thread(
+			[&]
+			{
+				search::StreamingClassifier classifier;
+				std::deque<Chunk*> waiting;
+
+				// Once their kinds are final, or straight away after a failure
+				const auto pass_on_final{
+					[&]
+					{
+						while (!waiting.empty())
+						{
+							auto* const chunk{waiting.front()};
+							const auto end{chunk->first_word + chunk->words.size()};
+							if (!failure.failed())
+							{
+								if (end > classifier.final_count())
+								{
+									return;
+								}
+
+								try
+								{
+									timed(decoder.busy,
+										  [&]
+										  {
+											  decode_classified(
+												  chunk->words,
+												  classifier.kinds(chunk->first_word,
+																   chunk->words.size()),
+												  chunk->instructions);
+											  classifier.release(end);
+										  });
+								}
+								catch (...)
+								{
+									failure.set(std::current_exception());
+								}
+							}
+
+							waiting.pop_front();
+							timed(decoder.waiting_for_output,
+								  [&] { decoded_chunks.push(chunk); });
+						}
+					}};
+
+				while (auto* const chunk{
+						   timed(decoder.waiting_for_input, [&] { return read_chunks.pop(); })})
+				{
+					if (!failure.failed())
+					{
+						try
+						{
+							timed(decoder.busy, [&] { classifier.push(chunk->words); });
+						}
+						catch (...)
+						{
+							failure.set(std::current_exception());
+						}
+					}
+
+					waiting.push_back(chunk);
+					pass_on_final();
+				}
+
+				if (!failure.failed())
+				{
+					classifier.finish();
+				}
+				pass_on_final();
+				timed(decoder.waiting_for_output, [&] { decoded_chunks.push(nullptr); });
+			});
+
+		const std::jthread formatter_thread(
+			[&]
+			{
+				run_stage(decoded_chunks, formatted_chunks, formatter, failure,
+						  [](Chunk& t_chunk)
+						  {
+							  for (std::size_t i_word{}; i_word < t_chunk.words.size(); ++i_word)
+							  {
+								  format_decoded(t_chunk.instructions[i_word],
+												 t_chunk.words[i_word], t_chunk.text);
+							  }
+						  });
+			});
+
+		// Hands the written chunks back to the reader
+		const std::jthread writer_thread(
+			[&]
+			{
+				run_stage(formatted_chunks, free_chunks, writer, failure,
+						  [&](Chunk& t_chunk)
+						  {
+							  for (const auto block : t_chunk.text.blocks())
+							  {
+								  t_output.write(block);
+							  }
+							  t_chunk.text.reset();
+						  });
+			});
+	}
+	report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+	failure.rethrow();
+	return report;
+}
+
+} // namespace dzl::pipeline
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,323 @@
+export module result_cache;
+
+import std;
+
+import unsigned_integer;
+import hash;
+
+import types;
+import instruction;
+import data_classifier;
+import disassembly;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::cache
+{
+// Chunks cover at most 4 KiB of address space and never cross a 4 KiB boundary
+constexpr std::size_t chunk_word_count{1024};
+constexpr std::size_t chunk_byte_size{chunk_word_count * sizeof(Word)};
+
+export struct ChunkResult
+{
+	std::vector<std::optional<ins::Instruction>> instructions;
+	std::string text;
+};
+
+export struct CacheStatistics
+{
+	std::size_t hits;
+	std::size_t misses;
+	std::size_t evictions;
+
+	[[nodiscard]] constexpr auto hit_rate() const noexcept
+	{
+		const auto lookups{hits + misses};
+		return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+	}
+};
+
+/*
+	Entry layout (host byte order, entries are not meant to be shared between machines):
+
+	magic, version, address, word count	 4 x u32
+	raw words							 word count x u32
+	word kinds							 word count x u8
+	instruction bits					 word count x u64 (all set when not decoded)
+	text size, text						 u64, text size x char
+
+	Kinds come from classifying the whole image, so they are part of the key: the same words
+	are code in one image and a literal pool in another.
+*/
+constexpr std::uint32_t entry_magic{0x435A'4C44};
+constexpr std::uint32_t entry_version{2};
+constexpr std::uint64_t undecoded_bits{~std::uint64_t{}};
+
+template <typename Type, std::size_t extent>
+auto write_values(std::ostream& t_stream, const std::span<const Type, extent> t_values) -> void
+{
+	t_stream.write(reinterpret_cast<const char*>(t_values.data()),
+				   static_cast<std::streamsize>(t_values.size_bytes()));
+}
+
+template <typename Type, std::size_t extent>
+[[nodiscard]] auto read_values(std::istream& t_stream, const std::span<Type, extent> t_values)
+	-> bool
+{
+	t_stream.read(reinterpret_cast<char*>(t_values.data()),
+				  static_cast<std::streamsize>(t_values.size_bytes()));
+	return static_cast<bool>(t_stream);
+}
+
+/*
+	Content-addressed on-disk store of decoded and formatted chunks, evicting the least recently
+	used entries once the directory exceeds its size limit
+*/
+export class ResultCache
+{
+public:
+	ResultCache(std::filesystem::path t_directory, const std::uintmax_t t_size_limit)
+		: m_directory(std::move(t_directory)), m_size_limit(t_size_limit)
+	{
+		std::filesystem::create_directories(m_directory);
+
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".chunk")
+			{
+				m_size += entry.file_size();
+			}
+		}
+	}
+
+	[[nodiscard]] auto find(const std::span<const Word> t_words,
+							const std::span<const search::WordKind> t_kinds,
+							const Address t_address) -> std::optional<ChunkResult>
+	{
+		auto result{load(entry_path(t_words, t_kinds, t_address), t_words, t_kinds, t_address)};
+		if (result)
+		{
+			++m_statistics.hits;
+		}
+		else
+		{
+			++m_statistics.misses;
+		}
+
+		return result;
+	}
+
+	auto store(const std::span<const Word> t_words, const std::span<const search::WordKind> t_kinds,
+			   const Address t_address, const ChunkResult& t_result) -> void
+	{
+		const auto path{entry_path(t_words, t_kinds, t_address)};
+		auto temporary_path{path};
+		temporary_path += ".tmp";
+
+		{
+			std::ofstream file(temporary_path, std::ios::binary);
+
+			const std::array header{entry_magic, entry_version, t_address.get(),
+									static_cast<std::uint32_t>(t_words.size())};
+			write_values(file, std::span(header));
+			write_values(file, t_words);
+			write_values(file, t_kinds);
+
+			std::vector<std::uint64_t> bits;
+			bits.reserve(t_result.instructions.size());
+			for (const auto instruction : t_result.instructions)
+			{
+				bits.push_back(instruction ? instruction->to_underlying().get() : undecoded_bits);
+			}
+			write_values(file, std::span<const std::uint64_t>(bits));
+
+			const std::array text_size{static_cast<std::uint64_t>(t_result.text.size())};
+			write_values(file, std::span(text_size));
+			write_values(file, std::span(t_result.text));
+
+			if (!file)
+			{
+				throw std::runtime_error(std::format("Cannot write {}", temporary_path.string()));
+			}
+		}
+
+		const auto existing_size{std::filesystem::exists(path) ? std::filesystem::file_size(path)
+															   : 0U};
+		const auto size{std::filesystem::file_size(temporary_path)};
+		std::filesystem::rename(temporary_path, path);
+
+		m_size = m_size - existing_size + size;
+		if (m_size > m_size_limit)
+		{
+			evict();
+		}
+	}
+
+	[[nodiscard]] auto statistics() const noexcept { return m_statistics; }
+
+private:
+	[[nodiscard]] auto entry_path(const std::span<const Word> t_words,
+								  const std::span<const search::WordKind> t_kinds,
+								  const Address t_address) const
+	{
+		const auto key{
+			xxhash64(std::as_bytes(t_kinds), xxhash64(std::as_bytes(t_words), t_address.get()))};
+		return m_directory / std::format("{:016x}.chunk", key);
+	}
+
+	[[nodiscard]] static auto load(const std::filesystem::path& t_path,
+								   const std::span<const Word> t_words,
+								   const std::span<const search::WordKind> t_kinds,
+								   const Address t_address)
+		-> std::optional<ChunkResult>
+	{
+		std::error_code error;
+		const auto file_size{std::filesystem::file_size(t_path, error)};
+		std::ifstream file(t_path, std::ios::binary);
+		if (error || !file)
+		{
+			return std::nullopt;
+		}
+
+		// Compare everything the key was derived from, so that hash collisions are harmless
+		std::array<std::uint32_t, 4> header{};
+		std::vector<Word> words(t_words.size());
+		std::vector<search::WordKind> kinds(t_kinds.size());
+		if (!read_values(file, std::span(header)) || header[0] != entry_magic ||
+			header[1] != entry_version || header[2] != t_address.get() ||
+			header[3] != t_words.size() || !read_values(file, std::span(words)) ||
+			!std::ranges::equal(words, t_words) || !read_values(file, std::span(kinds)) ||
+			!std::ranges::equal(kinds, t_kinds))
+		{
+			return std::nullopt;
+		}
+
+		std::vector<std::uint64_t> bits(t_words.size());
+		std::array<std::uint64_t, 1> text_size{};
+		if (!read_values(file, std::span(bits)) || !read_values(file, std::span(text_size)))
+		{
+			return std::nullopt;
+		}
+
+		// The text ends the entry, anything else is a corrupt or truncated entry
+		const auto position{file.tellg()};
+		if (position < 0 || text_size[0] != file_size - static_cast<std::uintmax_t>(position))
+		{
+			return std::nullopt;
+		}
+
+		ChunkResult result;
+		result.text.resize(text_size[0]);
+		if (!read_values(file, std::span(result.text)))
+		{
+			return std::nullopt;
+		}
+
+		result.instructions.reserve(bits.size());
+		for (const auto instruction_bits : bits)
+		{
+			result.instructions.push_back(
+				instruction_bits == undecoded_bits
+					? std::nullopt
+					: std::optional(ins::Instruction(Unsigned<8>(instruction_bits))));
+		}
+
+		// Hits refresh the entry for least recently used eviction
+		file.close();
+		std::filesystem::last_write_time(t_path, std::filesystem::file_time_type::clock::now(),
+										 error);
+
+		return result;
+	}
+
+	// Removes the oldest entries until the cache is back below 90% of its limit
+	auto evict() -> void
+	{
+		struct Entry
+		{
+			std::filesystem::path path;
+			std::uintmax_t size;
+			std::filesystem::file_time_type time;
+		};
+
+		std::vector<Entry> entries;
+		m_size = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".chunk")
+			{
+				entries.push_back({entry.path(), entry.file_size(), entry.last_write_time()});
+				m_size += entry.file_size();
+			}
+		}
+
+		std::ranges::sort(entries, std::ranges::less(), &Entry::time);
+
+		const auto target_size{m_size_limit / 10U * 9U};
+		for (const auto& entry : entries)
+		{
+			if (m_size <= target_size)
+			{
+				break;
+			}
+
+			std::error_code error;
+			if (std::filesystem::remove(entry.path, error))
+			{
+				m_size -= entry.size;
+				++m_statistics.evictions;
+			}
+		}
+	}
+
+	std::filesystem::path m_directory;
+	std::uintmax_t m_size_limit;
+	std::uintmax_t m_size{};
+	CacheStatistics m_statistics{};
+};
+
+/*
+	Disassembles an image chunk by chunk, only decoding and formatting chunks that are not
+	already cached. The image is classified as a whole, as without the cache.
+*/
+export auto disassemble(const std::span<const Word> t_words, const Address t_base,
+						ResultCache& t_cache, std::string& t_output) -> void
+{
+	const auto all_kinds{search::classify(t_words)};
+
+	std::size_t i_word{};
+	while (i_word < t_words.size())
+	{
+		const auto address{t_base + AddressOffset(static_cast<AddressOffset::Underlying>(
+										i_word * sizeof(Word)))};
+		const auto offset_in_chunk{(address.get() % chunk_byte_size) / sizeof(Word)};
+		const auto word_count{
+			std::min(chunk_word_count - offset_in_chunk, t_words.size() - i_word)};
+		const auto words{t_words.subspan(i_word, word_count)};
+		const auto kinds{std::span(all_kinds).subspan(i_word, word_count)};
+
+		if (const auto cached{t_cache.find(words, kinds, address)})
+		{
+			t_output += cached->text;
+		}
+		else
+		{
+			ChunkResult result;
+			decode_classified(words, kinds, result.instructions);
+			for (std::size_t i_chunk_word{}; i_chunk_word < word_count; ++i_chunk_word)
+			{
+				format_decoded(result.instructions[i_chunk_word], words[i_chunk_word],
+							   result.text);
+			}
+
+			t_cache.store(words, kinds, address, result);
+			t_output += result.text;
+		}
+
+		i_word += word_count;
+	}
+}
+
+} // namespace dzl::cache
+
+// NOLINTEND(*-magic-numbers)
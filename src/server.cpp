@@ -0,0 +1,790 @@
+module;
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+export module server;
+
+import std;
+
+import unsigned_integer;
+import mapped_file;
+import lru_cache;
+
+import types;
+import instruction;
+import image;
+import disassembly;
+import listing;
+import paged_view;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::server
+{
+/*
+	Protocol, in host byte order over a Unix domain socket (client and daemon share a machine).
+
+	A client sends fixed-size requests and reads a response header followed by size bytes of
+	text after each, over as many requests as it likes per connection. Images are identified by
+	their position on the daemon's command line.
+*/
+export constexpr std::uint32_t request_magic{0x515A'4C44};
+export constexpr std::uint32_t response_magic{0x525A'4C44};
+export constexpr std::uint8_t protocol_version{1};
+
+// Largest window of a single request
+export constexpr std::uint32_t max_request_word_count{1U << 16U};
+
+export enum struct RequestKind : std::uint8_t{Disassemble, Statistics, Shutdown};
+
+export enum struct OutputStyle : std::uint8_t{
+	Plain,				// As the default output
+	Listing,			// Address, word and instruction columns
+	ListingWithTargets, // Listing, with the target of every branch
+};
+
+export enum struct Status : std::uint32_t{Ok, UnknownImage, OutOfRange, BadRequest};
+
+export struct Request
+{
+	std::uint32_t magic{request_magic};
+	std::uint8_t version{protocol_version};
+	RequestKind kind{};
+	OutputStyle style{};
+	std::uint8_t reserved{};
+
+	std::uint32_t image{};
+	std::uint32_t address{};
+	std::uint32_t word_count{};
+};
+
+export struct ResponseHeader
+{
+	std::uint32_t magic{response_magic};
+	Status status{};
+	std::uint32_t size{};
+};
+
+static_assert(sizeof(Request) == 20 && std::is_trivially_copyable_v<Request>);
+static_assert(sizeof(ResponseHeader) == 12 && std::is_trivially_copyable_v<ResponseHeader>);
+
+export [[nodiscard]] constexpr auto status_name(const Status t_status) noexcept -> std::string_view
+{
+	switch (t_status)
+	{
+	case Status::Ok:
+		return "ok";
+	case Status::UnknownImage:
+		return "unknown image";
+	case Status::OutOfRange:
+		return "address outside the image";
+	case Status::BadRequest:
+		return "bad request";
+	}
+	return "unknown status";
+}
+
+/*
+	Sockets
+*/
+#if defined(__unix__) || defined(__APPLE__)
+class Socket
+{
+public:
+	Socket() = default;
+	explicit Socket(const int t_descriptor) : m_descriptor(t_descriptor) {}
+
+	Socket(const Socket&) = delete;
+	auto operator=(const Socket&) -> Socket& = delete;
+
+	Socket(Socket&& t_other) noexcept : m_descriptor(std::exchange(t_other.m_descriptor, -1)) {}
+	auto operator=(Socket&& t_other) noexcept -> Socket&
+	{
+		if (this != &t_other)
+		{
+			close();
+			m_descriptor = std::exchange(t_other.m_descriptor, -1);
+		}
+		return *this;
+	}
+
+	~Socket() { close(); }
+
+	[[nodiscard]] auto descriptor() const noexcept { return m_descriptor; }
+
+	// False once the timeout passed without anything to read
+	[[nodiscard]] auto wait_readable(const std::chrono::milliseconds t_timeout) const -> bool
+	{
+		pollfd descriptor{.fd = m_descriptor, .events = POLLIN, .revents = 0};
+		const auto ready{::poll(&descriptor, 1, static_cast<int>(t_timeout.count()))};
+		if (ready < 0 && errno != EINTR)
+		{
+			throw std::system_error(errno, std::generic_category(), "poll");
+		}
+		return ready > 0;
+	}
+
+	// False when the peer closed the connection before the first byte
+	[[nodiscard]] auto read_exact(const std::span<std::byte> t_bytes) const -> bool
+	{
+		std::size_t received{};
+		while (received < t_bytes.size())
+		{
+			const auto size{::recv(m_descriptor, t_bytes.data() + received,
+								   t_bytes.size() - received, 0)};
+			if (size == 0 && received == 0)
+			{
+				return false;
+			}
+			if (size == 0)
+			{
+				throw std::runtime_error("Connection closed mid-message");
+			}
+			if (size < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::system_error(errno, std::generic_category(), "recv");
+			}
+			received += static_cast<std::size_t>(size);
+		}
+		return true;
+	}
+
+	auto write_all(std::span<const std::byte> t_bytes) const -> void
+	{
+#if defined(MSG_NOSIGNAL)
+		constexpr int flags{MSG_NOSIGNAL};
+#else
+		constexpr int flags{};
+#endif
+		while (!t_bytes.empty())
+		{
+			const auto size{::send(m_descriptor, t_bytes.data(), t_bytes.size(), flags)};
+			if (size < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				throw std::system_error(errno, std::generic_category(), "send");
+			}
+			t_bytes = t_bytes.subspan(static_cast<std::size_t>(size));
+		}
+	}
+
+	// Empty when the connection went away before it was accepted or descriptors ran out, which
+	// only costs that connection
+	[[nodiscard]] auto accept() const -> std::optional<Socket>
+	{
+		const auto descriptor{::accept(m_descriptor, nullptr, nullptr)};
+		if (descriptor >= 0)
+		{
+			return Socket(descriptor);
+		}
+
+		constexpr std::array transient_errors{EINTR,  EAGAIN, EWOULDBLOCK, ECONNABORTED, EPROTO,
+											  EMFILE, ENFILE, ENOBUFS,     ENOMEM};
+		if (std::ranges::contains(transient_errors, errno))
+		{
+			return std::nullopt;
+		}
+		throw std::system_error(errno, std::generic_category(), "accept");
+	}
+
+	[[nodiscard]] static auto listen(const std::filesystem::path& t_path) -> Socket
+	{
+		Socket socket(make_socket());
+		const auto address{make_address(t_path)};
+
+		// A socket left behind by a daemon that did not shut down cleanly
+		if (std::filesystem::is_socket(t_path))
+		{
+			std::filesystem::remove(t_path);
+		}
+
+		if (::bind(socket.m_descriptor, reinterpret_cast<const sockaddr*>(&address),
+				   sizeof(address)) != 0 ||
+			::listen(socket.m_descriptor, SOMAXCONN) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(),
+									std::format("Cannot listen on {}", t_path.string()));
+		}
+		return socket;
+	}
+
+	[[nodiscard]] static auto connect(const std::filesystem::path& t_path) -> Socket
+	{
+		Socket socket(make_socket());
+		const auto address{make_address(t_path)};
+
+		if (::connect(socket.m_descriptor, reinterpret_cast<const sockaddr*>(&address),
+					  sizeof(address)) != 0)
+		{
+			throw std::system_error(errno, std::generic_category(),
+									std::format("Cannot connect to {}", t_path.string()));
+		}
+		return socket;
+	}
+
+private:
+	[[nodiscard]] static auto make_socket() -> int
+	{
+		const auto descriptor{::socket(AF_UNIX, SOCK_STREAM, 0)};
+		if (descriptor < 0)
+		{
+			throw std::system_error(errno, std::generic_category(), "socket");
+		}
+		return descriptor;
+	}
+
+	[[nodiscard]] static auto make_address(const std::filesystem::path& t_path) -> sockaddr_un
+	{
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+
+		const auto& path{t_path.native()};
+		if (path.size() >= sizeof(address.sun_path))
+		{
+			throw std::invalid_argument(std::format("Socket path too long: {}", t_path.string()));
+		}
+		std::ranges::copy(path, address.sun_path);
+		return address;
+	}
+
+	auto close() noexcept -> void
+	{
+		if (m_descriptor >= 0)
+		{
+			::close(m_descriptor);
+			m_descriptor = -1;
+		}
+	}
+
+	int m_descriptor{-1};
+};
+#else
+// Only Unix domain sockets are implemented
+class Socket
+{
+public:
+	[[nodiscard]] auto wait_readable(std::chrono::milliseconds) const -> bool { unsupported(); }
+	[[nodiscard]] auto read_exact(std::span<std::byte>) const -> bool { unsupported(); }
+	auto write_all(std::span<const std::byte>) const -> void { unsupported(); }
+	[[nodiscard]] auto accept() const -> std::optional<Socket> { unsupported(); }
+
+	[[nodiscard]] static auto listen(const std::filesystem::path&) -> Socket { unsupported(); }
+	[[nodiscard]] static auto connect(const std::filesystem::path&) -> Socket { unsupported(); }
+
+private:
+	[[noreturn]] static auto unsupported() -> void
+	{
+		throw std::runtime_error("The daemon needs Unix domain sockets");
+	}
+};
+#endif
+
+template <typename Type> auto read_struct(const Socket& t_socket, Type& t_value) -> bool
+{
+	return t_socket.read_exact(std::as_writable_bytes(std::span(&t_value, 1)));
+}
+
+template <typename Type> auto write_struct(const Socket& t_socket, const Type& t_value) -> void
+{
+	t_socket.write_all(std::as_bytes(std::span(&t_value, 1)));
+}
+
+/*
+	Images stay mapped and decoded for the daemon's lifetime
+*/
+export struct ImageSource
+{
+	std::filesystem::path path;
+	Address base;
+	std::endian endianness{std::endian::little};
+};
+
+class WarmImage
+{
+public:
+	explicit WarmImage(const ImageSource& t_source) : m_file(t_source.path), m_base(t_source.base)
+	{
+		const auto bytes{m_file.bytes()};
+		const auto word_count{bytes.size() / sizeof(Word)};
+
+		// Mappings are page aligned, so the words are used in place unless they need swapping
+		if (t_source.endianness == std::endian::native)
+		{
+			m_words = std::span(reinterpret_cast<const Word*>(bytes.data()), word_count);
+		}
+		else
+		{
+			m_swapped.resize(word_count);
+			std::memcpy(m_swapped.data(), bytes.data(), word_count * sizeof(Word));
+			io::to_native(m_swapped, t_source.endianness);
+			m_words = m_swapped;
+		}
+
+		// Classified once over the whole image, so that no window sees a partial picture
+		m_instructions = decode_classified(m_words);
+	}
+
+	[[nodiscard]] auto base() const noexcept { return m_base; }
+	[[nodiscard]] auto words() const noexcept { return m_words; }
+	[[nodiscard]] auto instructions() const noexcept -> std::span<const std::optional<ins::Instruction>>
+	{
+		return m_instructions;
+	}
+
+	// Index of the word at t_address, if inside the image
+	[[nodiscard]] auto word_index(const Address t_address) const noexcept
+		-> std::optional<std::size_t>
+	{
+		return io::word_index(m_base, t_address, m_words.size());
+	}
+
+private:
+	MappedFile m_file;
+	Address m_base;
+
+	std::vector<Word> m_swapped;
+	std::span<const Word> m_words;
+	std::vector<std::optional<ins::Instruction>> m_instructions;
+};
+
+/*
+	Formatted text is cached per chunk of an image and output style
+*/
+constexpr std::size_t chunk_word_count{1024};
+
+using ChunkKey = std::uint64_t;
+
+[[nodiscard]] constexpr auto make_chunk_key(const std::size_t t_image, const OutputStyle t_style,
+											const std::size_t t_chunk) noexcept
+{
+	return (static_cast<ChunkKey>(t_image) << 40U) | (static_cast<ChunkKey>(t_style) << 32U) |
+		   static_cast<ChunkKey>(t_chunk);
+}
+
+[[nodiscard]] auto format_chunk(const WarmImage& t_image, const std::size_t t_chunk,
+								const OutputStyle t_style) -> views::FormattedPage
+{
+	const auto first{t_chunk * chunk_word_count};
+	const auto count{std::min(chunk_word_count, t_image.words().size() - first)};
+	const auto base{t_image.base() +
+					AddressOffset(static_cast<AddressOffset::Underlying>(4 * first))};
+
+	return views::format_page(
+		t_image.words().subspan(first, count), t_image.instructions().subspan(first, count), base,
+		t_style == OutputStyle::Plain
+			? std::nullopt
+			: std::optional(listing::Options{
+				  .branch_targets = t_style == OutputStyle::ListingWithTargets}));
+}
+
+/*
+	Latencies of the most recent requests
+*/
+class LatencyRecorder
+{
+public:
+	auto record(const std::chrono::nanoseconds t_latency) -> void
+	{
+		if (m_samples.size() < sample_count)
+		{
+			m_samples.push_back(t_latency);
+		}
+		else
+		{
+			m_samples[m_next] = t_latency;
+		}
+		m_next = (m_next + 1) % sample_count;
+	}
+
+	// Nearest-rank percentile, zero before the first request
+	[[nodiscard]] auto percentile(const double t_percent) const -> std::chrono::nanoseconds
+	{
+		if (m_samples.empty())
+		{
+			return {};
+		}
+
+		auto samples{m_samples};
+		const auto rank{static_cast<std::size_t>(
+			std::ceil(t_percent / 100.0 * static_cast<double>(samples.size())))};
+		const auto nth{samples.begin() +
+					   static_cast<std::ptrdiff_t>(std::clamp(rank, 1UZ, samples.size()) - 1)};
+		std::ranges::nth_element(samples, nth);
+		return *nth;
+	}
+
+private:
+	static constexpr std::size_t sample_count{1UZ << 16U};
+
+	std::vector<std::chrono::nanoseconds> m_samples;
+	std::size_t m_next{};
+};
+
+export struct ServerStatistics
+{
+	std::size_t requests;
+	std::size_t failed_requests;
+	std::size_t failed_accepts;
+
+	std::size_t chunk_hits;
+	std::size_t chunk_misses;
+	std::size_t chunk_evictions;
+
+	std::chrono::nanoseconds p50;
+	std::chrono::nanoseconds p99;
+
+	[[nodiscard]] constexpr auto hit_rate() const noexcept
+	{
+		const auto lookups{chunk_hits + chunk_misses};
+		return lookups == 0 ? 0.0 : static_cast<double>(chunk_hits) / static_cast<double>(lookups);
+	}
+};
+
+// One "<name> <value>" per line, as answered to statistics requests
+export [[nodiscard]] auto format_statistics(const ServerStatistics& t_statistics) -> std::string
+{
+	const auto microseconds{[](const std::chrono::nanoseconds t_duration)
+							{ return std::chrono::duration<double, std::micro>(t_duration).count(); }};
+
+	return std::format("requests {}\n"
+					   "failed_requests {}\n"
+					   "chunk_hits {}\n"
+					   "chunk_misses {}\n"
+					   "chunk_evictions {}\n"
+					   "p50_us {:.1f}\n"
+					   "p99_us {:.1f}\n"
+					   "failed_accepts {}\n",
+					   t_statistics.requests, t_statistics.failed_requests, t_statistics.chunk_hits,
+					   t_statistics.chunk_misses, t_statistics.chunk_evictions,
+					   microseconds(t_statistics.p50), microseconds(t_statistics.p99),
+					   t_statistics.failed_accepts);
+}
+
+/*
+	Daemon serving disassembly windows of its images, a thread per connection
+*/
+export struct ServerOptions
+{
+	std::filesystem::path socket_path;
+
+	// Formatted text kept in memory, in bytes
+	std::size_t cache_size{256UZ << 20U};
+};
+
+export class Server
+{
+public:
+	Server(const std::span<const ImageSource> t_images, ServerOptions t_options)
+		: m_options(std::move(t_options)), m_chunks(m_options.cache_size)
+	{
+		m_images.reserve(t_images.size());
+		for (const auto& image : t_images)
+		{
+			m_images.push_back(std::make_unique<WarmImage>(image));
+		}
+
+		m_listener = Socket::listen(m_options.socket_path);
+	}
+
+	Server(const Server&) = delete;
+	Server(Server&&) = delete;
+	auto operator=(const Server&) -> Server& = delete;
+	auto operator=(Server&&) -> Server& = delete;
+
+	~Server()
+	{
+		stop();
+		m_connections.clear();
+
+		std::error_code error;
+		std::filesystem::remove(m_options.socket_path, error);
+	}
+
+	// Serves until stop() or a shutdown request
+	auto run() -> void
+	{
+		while (!m_stopping)
+		{
+			if (m_listener.wait_readable(poll_interval))
+			{
+				if (auto socket{m_listener.accept()})
+				{
+					m_connections.emplace_back([this](Socket t_socket) { serve(t_socket); },
+											   std::move(*socket));
+				}
+				else
+				{
+					{
+						const std::scoped_lock lock(m_mutex);
+						++m_failed_accepts;
+					}
+
+					// A connection refused for lack of descriptors stays queued, so the listener
+					// would be readable again straight away
+					std::this_thread::sleep_for(accept_retry_interval);
+				}
+			}
+
+			// Finished connections are joined as new ones come and go
+			std::erase_if(m_connections, [](const Connection& t_connection)
+						  { return t_connection.finished(); });
+		}
+		m_connections.clear();
+	}
+
+	auto stop() noexcept -> void { m_stopping = true; }
+
+	[[nodiscard]] auto statistics() const -> ServerStatistics
+	{
+		const std::scoped_lock lock(m_mutex);
+		return {.requests = m_requests,
+				.failed_requests = m_failed_requests,
+				.failed_accepts = m_failed_accepts,
+				.chunk_hits = m_chunk_hits,
+				.chunk_misses = m_chunk_misses,
+				.chunk_evictions = m_chunk_evictions,
+				.p50 = m_latencies.percentile(50.0),
+				.p99 = m_latencies.percentile(99.0)};
+	}
+
+private:
+	static constexpr std::chrono::milliseconds poll_interval{100};
+	static constexpr std::chrono::milliseconds accept_retry_interval{10};
+
+	class Connection
+	{
+	public:
+		Connection(std::invocable<Socket> auto t_serve, Socket t_socket)
+			: m_finished(std::make_shared<std::atomic<bool>>()),
+			  m_thread(
+				  [serve = std::move(t_serve), finished = m_finished](Socket t_connection) mutable
+				  {
+					  serve(std::move(t_connection));
+					  *finished = true;
+				  },
+				  std::move(t_socket))
+		{
+		}
+
+		[[nodiscard]] auto finished() const noexcept -> bool { return *m_finished; }
+
+	private:
+		std::shared_ptr<std::atomic<bool>> m_finished;
+		std::jthread m_thread;
+	};
+
+	auto serve(const Socket& t_socket) noexcept -> void
+	{
+		try
+		{
+			while (!m_stopping)
+			{
+				if (!t_socket.wait_readable(poll_interval))
+				{
+					continue;
+				}
+
+				Request request;
+				if (!read_struct(t_socket, request))
+				{
+					return;
+				}
+
+				const auto start{std::chrono::steady_clock::now()};
+				const auto [status, text]{answer(request)};
+
+				// Counted before answering, so that a client sees its earlier requests
+				{
+					const std::scoped_lock lock(m_mutex);
+					++m_requests;
+					m_failed_requests += status == Status::Ok ? 0 : 1;
+					m_latencies.record(std::chrono::steady_clock::now() - start);
+				}
+
+				write_struct(t_socket, ResponseHeader{.status = status,
+													  .size = static_cast<std::uint32_t>(text.size())});
+				t_socket.write_all(std::as_bytes(std::span(text)));
+			}
+		}
+		catch (const std::exception&)
+		{
+			// A client that went away only ends its own connection
+		}
+	}
+
+	[[nodiscard]] auto answer(const Request& t_request) -> std::pair<Status, std::string>
+	{
+		if (t_request.magic != request_magic || t_request.version != protocol_version)
+		{
+			return {Status::BadRequest, {}};
+		}
+
+		switch (t_request.kind)
+		{
+		case RequestKind::Disassemble:
+			return disassemble(t_request);
+		case RequestKind::Statistics:
+			return {Status::Ok, format_statistics(statistics())};
+		case RequestKind::Shutdown:
+			stop();
+			return {Status::Ok, {}};
+		}
+		return {Status::BadRequest, {}};
+	}
+
+	[[nodiscard]] auto disassemble(const Request& t_request) -> std::pair<Status, std::string>
+	{
+		if (t_request.image >= m_images.size())
+		{
+			return {Status::UnknownImage, {}};
+		}
+		if (t_request.word_count > max_request_word_count ||
+			t_request.style > OutputStyle::ListingWithTargets)
+		{
+			return {Status::BadRequest, {}};
+		}
+
+		const auto& image{*m_images[t_request.image]};
+		const auto first{image.word_index(Address(t_request.address))};
+		if (!first)
+		{
+			return {Status::OutOfRange, {}};
+		}
+
+		// Windows running past the end of the image are cut short
+		const auto end{std::min(*first + t_request.word_count, image.words().size())};
+
+		std::string text;
+		for (auto i_word{*first}; i_word < end;)
+		{
+			const auto chunk_index{i_word / chunk_word_count};
+			const auto chunk_first{chunk_index * chunk_word_count};
+			const auto count{std::min(end, chunk_first + chunk_word_count) - i_word};
+
+			const auto chunk{get_chunk(t_request.image, t_request.style, chunk_index)};
+			text.append(chunk->lines(i_word - chunk_first, count));
+			i_word += count;
+		}
+		return {Status::Ok, std::move(text)};
+	}
+
+	[[nodiscard]] auto get_chunk(const std::size_t t_image, const OutputStyle t_style,
+								 const std::size_t t_chunk) -> std::shared_ptr<const views::FormattedPage>
+	{
+		const auto key{make_chunk_key(t_image, t_style, t_chunk)};
+		{
+			const std::scoped_lock lock(m_mutex);
+			if (auto chunk{m_chunks.find(key)})
+			{
+				++m_chunk_hits;
+				return chunk;
+			}
+			++m_chunk_misses;
+		}
+
+		// Formatted without the lock, so that other connections keep being served meanwhile
+		auto chunk{std::make_shared<const views::FormattedPage>(
+			format_chunk(*m_images[t_image], t_chunk, t_style))};
+
+		// Another connection may have formatted the same chunk meanwhile, the first one stays
+		const std::scoped_lock lock(m_mutex);
+		m_chunk_evictions += m_chunks.insert(key, chunk, chunk->text.size());
+		return chunk;
+	}
+
+	ServerOptions m_options;
+	std::vector<std::unique_ptr<WarmImage>> m_images;
+
+	Socket m_listener;
+	std::vector<Connection> m_connections;
+	std::atomic<bool> m_stopping{};
+
+	mutable std::mutex m_mutex;
+	LruCache<ChunkKey, views::FormattedPage> m_chunks;
+	std::size_t m_chunk_hits{};
+	std::size_t m_chunk_misses{};
+	std::size_t m_chunk_evictions{};
+	LatencyRecorder m_latencies;
+	std::size_t m_requests{};
+	std::size_t m_failed_requests{};
+	std::size_t m_failed_accepts{};
+};
+
+/*
+	Client side of the protocol, one connection per client
+*/
+export class Client
+{
+public:
+	explicit Client(const std::filesystem::path& t_socket_path)
+		: m_socket(Socket::connect(t_socket_path))
+	{
+	}
+
+	[[nodiscard]] auto disassemble(const std::uint32_t t_image, const Address t_address,
+								   const std::uint32_t t_word_count,
+								   const OutputStyle t_style = OutputStyle::Plain) -> std::string
+	{
+		return exchange({.kind = RequestKind::Disassemble,
+						 .style = t_style,
+						 .image = t_image,
+						 .address = t_address.get(),
+						 .word_count = t_word_count});
+	}
+
+	[[nodiscard]] auto statistics() -> std::string
+	{
+		return exchange({.kind = RequestKind::Statistics});
+	}
+
+	auto shutdown() -> void { static_cast<void>(exchange({.kind = RequestKind::Shutdown})); }
+
+	// The raw exchange, without interpreting the status
+	[[nodiscard]] auto send(const Request& t_request) -> std::pair<Status, std::string>
+	{
+		write_struct(m_socket, t_request);
+
+		ResponseHeader header;
+		if (!read_struct(m_socket, header) || header.magic != response_magic)
+		{
+			throw std::runtime_error("Invalid response from the daemon");
+		}
+
+		std::string text(header.size, '\0');
+		if (!text.empty() && !m_socket.read_exact(std::as_writable_bytes(std::span(text))))
+		{
+			throw std::runtime_error("Connection closed by the daemon");
+		}
+		return {header.status, std::move(text)};
+	}
+
+private:
+	[[nodiscard]] auto exchange(const Request& t_request) -> std::string
+	{
+		auto [status, text]{send(t_request)};
+		if (status != Status::Ok)
+		{
+			throw std::runtime_error(std::format("Request failed: {}", status_name(status)));
+		}
+		return std::move(text);
+	}
+
+	Socket m_socket;
+};
+
+} // namespace dzl::server
+
+// NOLINTEND(*-magic-numbers)
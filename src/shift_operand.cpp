@@ -109,6 +109,8 @@ public:
 		return OperandType(m_underlying);
 	}
 
+	[[nodiscard]] constexpr auto to_underlying() const noexcept { return m_underlying; }
+
 private:
 	ShiftOperandBits m_underlying;
 };
@@ -0,0 +1,428 @@
+export module symbol_table;
+
+import std;
+
+import unsigned_integer;
+import mapped_file;
+
+import types;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::symbols
+{
+export struct Symbol
+{
+	Address address;
+	std::string_view name;
+};
+
+// An address as the symbol at or before it, plus the distance from it
+export struct SymbolReference
+{
+	std::string_view name;
+	AddressOffset offset;
+};
+
+/*
+	Address to symbol lookup, built once and then read-only.
+
+	Start addresses are kept in Eytzinger (breadth-first) order, so that the first levels of every
+	search share a few cache lines and the children of each node are adjacent. The search always
+	takes the same number of steps for a given size, choosing a child with arithmetic rather than a
+	branch. Names are interned into a single blob.
+*/
+export class SymbolTable
+{
+public:
+	SymbolTable() = default;
+
+	// Symbols in any order; of several at the same address, the first is kept
+	explicit SymbolTable(const std::span<const Symbol> t_symbols)
+	{
+		std::vector<Symbol> sorted(t_symbols.begin(), t_symbols.end());
+		std::ranges::stable_sort(sorted, std::ranges::less(),
+								 [](const Symbol& t_symbol) { return t_symbol.address.get(); });
+		const auto duplicates{std::ranges::unique(sorted, std::ranges::equal_to(),
+												  [](const Symbol& t_symbol)
+												  { return t_symbol.address.get(); })};
+		sorted.erase(duplicates.begin(), duplicates.end());
+
+		if (sorted.size() >= std::numeric_limits<std::uint32_t>::max())
+		{
+			throw std::invalid_argument("Too many symbols");
+		}
+
+		std::unordered_map<std::string_view, Name> interned;
+		m_addresses.reserve(sorted.size());
+		m_names.reserve(sorted.size());
+		for (const auto& [address, name] : sorted)
+		{
+			const auto [entry, inserted]{interned.try_emplace(
+				name, Name{.offset = static_cast<std::uint32_t>(m_name_blob.size()),
+						   .size = static_cast<std::uint32_t>(name.size())})};
+			if (inserted)
+			{
+				m_name_blob.append(name);
+			}
+
+			m_addresses.push_back(address.get());
+			m_names.push_back(entry->second);
+		}
+
+		// Slot 0 is unused, so that the children of slot k are 2k and 2k + 1
+		m_keys.resize(sorted.size() + 1);
+		m_ranks.resize(sorted.size() + 1);
+		m_ranks[0] = static_cast<std::uint32_t>(sorted.size());
+
+		std::uint32_t rank{};
+		fill(1, rank);
+	}
+
+	[[nodiscard]] auto size() const noexcept { return m_addresses.size(); }
+	[[nodiscard]] auto empty() const noexcept { return m_addresses.empty(); }
+
+	// Every name, each stored once
+	[[nodiscard]] auto name_blob() const noexcept -> std::string_view { return m_name_blob; }
+
+	// Symbols in address order
+	[[nodiscard]] auto operator[](const std::size_t t_index) const noexcept
+	{
+		return Symbol{.address = Address(m_addresses[t_index]), .name = name(t_index)};
+	}
+
+	// The symbol at or before t_address, if any
+	[[nodiscard]] auto find(const Address t_address) const noexcept -> std::optional<SymbolReference>
+	{
+		const auto rank{upper_bound(t_address.get())};
+		if (rank == 0)
+		{
+			return std::nullopt;
+		}
+
+		const auto index{rank - 1};
+		return SymbolReference{.name = name(index),
+							   .offset = t_address - Address(m_addresses[index])};
+	}
+
+private:
+	struct Name
+	{
+		std::uint32_t offset;
+		std::uint32_t size;
+	};
+
+	// In-order traversal of the implicit tree, handing out sorted addresses
+	auto fill(const std::size_t t_slot, std::uint32_t& t_rank) -> void
+	{
+		if (t_slot >= m_keys.size())
+		{
+			return;
+		}
+
+		fill(2 * t_slot, t_rank);
+		m_keys[t_slot] = m_addresses[t_rank];
+		m_ranks[t_slot] = t_rank;
+		++t_rank;
+		fill((2 * t_slot) + 1, t_rank);
+	}
+
+	// Number of symbols at or before t_address
+	[[nodiscard]] auto upper_bound(const std::uint32_t t_address) const noexcept -> std::uint32_t
+	{
+		const auto count{m_keys.size() - 1};
+
+		std::size_t slot{1};
+		while (slot <= count)
+		{
+			// The 16 slots four levels down share a cache line
+			__builtin_prefetch(m_keys.data() + std::min(16 * slot, count));
+			slot = (2 * slot) + static_cast<std::size_t>(m_keys[slot] <= t_address);
+		}
+
+		// Undo the final right turns and the left turn before them, leaving the first greater slot
+		slot >>= static_cast<unsigned>(std::countr_one(slot) + 1);
+		return m_ranks[slot];
+	}
+
+	[[nodiscard]] auto name(const std::size_t t_index) const noexcept
+	{
+		const auto [offset, size]{m_names[t_index]};
+		return std::string_view(m_name_blob).substr(offset, size);
+	}
+
+	// Eytzinger order
+	std::vector<std::uint32_t> m_keys{0};
+	std::vector<std::uint32_t> m_ranks{0};
+
+	// Address order
+	std::vector<std::uint32_t> m_addresses;
+	std::vector<Name> m_names;
+
+	std::string m_name_blob;
+};
+
+/*
+	Map files have one "<address> <name>" per line with a hexadecimal address, optionally
+	0x-prefixed. The "<address> <type> <name>" lines of nm are accepted too. Empty lines and lines
+	starting with '#' are skipped.
+*/
+[[nodiscard]] auto parse_map_line(const std::string_view t_line) -> std::optional<Symbol>
+{
+	std::array<std::string_view, 3> fields{};
+	std::size_t field_count{};
+	for (const auto field : t_line | std::views::split(' '))
+	{
+		if (field.empty())
+		{
+			continue;
+		}
+		if (field_count == fields.size())
+		{
+			return std::nullopt;
+		}
+		fields[field_count++] = std::string_view(field.begin(), field.end());
+	}
+
+	if (field_count < 2)
+	{
+		return std::nullopt;
+	}
+
+	auto digits{fields[0]};
+	if (digits.starts_with("0x") || digits.starts_with("0X"))
+	{
+		digits.remove_prefix(2);
+	}
+
+	std::uint32_t address{};
+	const auto [end, error]{
+		std::from_chars(digits.data(), digits.data() + digits.size(), address, 16)};
+	if (error != std::errc() || end != digits.data() + digits.size() || digits.empty())
+	{
+		return std::nullopt;
+	}
+
+	return Symbol{.address = Address(address), .name = fields[field_count - 1]};
+}
+
+export [[nodiscard]] auto parse_map(const std::string_view t_text) -> SymbolTable
+{
+	std::vector<Symbol> symbols;
+	std::size_t line_number{};
+	for (const auto range : t_text | std::views::split('\n'))
+	{
+		++line_number;
+
+		auto line{std::string_view(range.begin(), range.end())};
+		if (line.ends_with('\r'))
+		{
+			line.remove_suffix(1);
+		}
+		if (line.empty() || line.starts_with('#'))
+		{
+			continue;
+		}
+
+		const auto symbol{parse_map_line(line)};
+		if (!symbol)
+		{
+			throw std::runtime_error(
+				std::format("Malformed map file line {}: {}", line_number, line));
+		}
+		symbols.push_back(*symbol);
+	}
+
+	return SymbolTable(symbols);
+}
+
+/*
+	ELF32 symbol tables (.symtab, or .dynsym when stripped), in either byte order
+*/
+constexpr std::size_t elf_header_size{52};
+constexpr std::size_t elf_section_size{40};
+constexpr std::size_t elf_symbol_size{16};
+
+constexpr std::uint32_t section_symbol_table{2};
+constexpr std::uint32_t section_dynamic_symbols{11};
+
+constexpr std::uint8_t symbol_no_type{0};
+constexpr std::uint8_t symbol_function{2};
+
+class ElfReader
+{
+public:
+	ElfReader(const std::span<const std::byte> t_bytes, const std::endian t_endianness)
+		: m_bytes(t_bytes), m_endianness(t_endianness)
+	{
+	}
+
+	template <std::unsigned_integral Type>
+	[[nodiscard]] auto read(const std::size_t t_offset) const -> Type
+	{
+		if (t_offset > m_bytes.size() || sizeof(Type) > m_bytes.size() - t_offset)
+		{
+			throw std::runtime_error("Truncated ELF file");
+		}
+
+		Type value{};
+		std::memcpy(&value, m_bytes.data() + t_offset, sizeof(Type));
+		return m_endianness == std::endian::native ? value : std::byteswap(value);
+	}
+
+	[[nodiscard]] auto bytes(const std::size_t t_offset, const std::size_t t_size) const
+	{
+		if (t_offset > m_bytes.size() || t_size > m_bytes.size() - t_offset)
+		{
+			throw std::runtime_error("Truncated ELF file");
+		}
+		return m_bytes.subspan(t_offset, t_size);
+	}
+
+private:
+	std::span<const std::byte> m_bytes;
+	std::endian m_endianness;
+};
+
+export [[nodiscard]] auto is_elf(const std::span<const std::byte> t_bytes) noexcept
+{
+	constexpr std::array magic{std::byte{0x7F}, std::byte{'E'}, std::byte{'L'}, std::byte{'F'}};
+	return t_bytes.size() >= magic.size() && std::ranges::equal(t_bytes.first(magic.size()), magic);
+}
+
+export [[nodiscard]] auto parse_elf(const std::span<const std::byte> t_bytes) -> SymbolTable
+{
+	if (!is_elf(t_bytes) || t_bytes.size() < elf_header_size)
+	{
+		throw std::runtime_error("Not an ELF file");
+	}
+	if (t_bytes[4] != std::byte{1})
+	{
+		throw std::runtime_error("Only 32-bit ELF files are supported");
+	}
+
+	const ElfReader elf(t_bytes, t_bytes[5] == std::byte{2} ? std::endian::big : std::endian::little);
+
+	const auto section_offset{elf.read<std::uint32_t>(32)};
+	const auto section_entry_size{elf.read<std::uint16_t>(46)};
+	const auto section_count{elf.read<std::uint16_t>(48)};
+	if (section_count != 0 && section_entry_size < elf_section_size)
+	{
+		throw std::runtime_error("Invalid ELF section header size");
+	}
+
+	const auto section_header{[&](const std::size_t t_index)
+							  { return section_offset + (t_index * section_entry_size); }};
+
+	// The full symbol table when present, the dynamic one otherwise
+	std::optional<std::size_t> symbol_section;
+	for (std::size_t i_section{}; i_section < section_count; ++i_section)
+	{
+		const auto type{elf.read<std::uint32_t>(section_header(i_section) + 4)};
+		if (type == section_symbol_table)
+		{
+			symbol_section = i_section;
+			break;
+		}
+		if (type == section_dynamic_symbols && !symbol_section)
+		{
+			symbol_section = i_section;
+		}
+	}
+
+	if (!symbol_section)
+	{
+		return {};
+	}
+
+	const auto symbol_header{section_header(*symbol_section)};
+	const auto symbols_bytes{elf.bytes(elf.read<std::uint32_t>(symbol_header + 16),
+									   elf.read<std::uint32_t>(symbol_header + 20))};
+	const auto entry_size{std::max<std::size_t>(elf.read<std::uint32_t>(symbol_header + 36),
+												elf_symbol_size)};
+
+	// Names live in the string table section linked from the symbol table
+	const auto string_index{elf.read<std::uint32_t>(symbol_header + 24)};
+	if (string_index >= section_count)
+	{
+		throw std::runtime_error("Invalid ELF string table");
+	}
+	const auto string_header{section_header(string_index)};
+	const auto strings_bytes{elf.bytes(elf.read<std::uint32_t>(string_header + 16),
+									   elf.read<std::uint32_t>(string_header + 20))};
+	const std::string_view strings(reinterpret_cast<const char*>(strings_bytes.data()),
+								   strings_bytes.size());
+
+	const auto symbols_offset{static_cast<std::size_t>(symbols_bytes.data() - t_bytes.data())};
+	std::vector<Symbol> symbols;
+	symbols.reserve(symbols_bytes.size() / entry_size);
+
+	for (std::size_t i_symbol{}; (i_symbol + 1) * entry_size <= symbols_bytes.size(); ++i_symbol)
+	{
+		const auto symbol{symbols_offset + (i_symbol * entry_size)};
+		const auto name_offset{elf.read<std::uint32_t>(symbol)};
+		const auto value{elf.read<std::uint32_t>(symbol + 4)};
+		const auto type{static_cast<std::uint8_t>(elf.read<std::uint8_t>(symbol + 12) & 0xFU)};
+		const auto section{elf.read<std::uint16_t>(symbol + 14)};
+
+		// Undefined symbols have no address, other types are not branch targets
+		if (section == 0 || (type != symbol_function && type != symbol_no_type) ||
+			name_offset >= strings.size())
+		{
+			continue;
+		}
+
+		const auto name_end{strings.find('\0', name_offset)};
+		const auto name{strings.substr(name_offset, name_end - name_offset)};
+
+		// $a, $d and $t only mark where ARM code, data and Thumb code start
+		if (name.empty() || name.starts_with('$'))
+		{
+			continue;
+		}
+
+		// Bit 0 of a function address selects Thumb state
+		const auto address{type == symbol_function ? value & ~1U : value};
+		symbols.push_back(Symbol{.address = Address(address), .name = name});
+	}
+
+	return SymbolTable(symbols);
+}
+
+// ELF files by their magic, map files otherwise
+export [[nodiscard]] auto load_symbols(const std::filesystem::path& t_path) -> SymbolTable
+{
+	const MappedFile file(t_path);
+	const auto bytes{file.bytes()};
+
+	if (is_elf(bytes))
+	{
+		return parse_elf(bytes);
+	}
+
+	return parse_map(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+}
+
+} // namespace dzl::symbols
+
+// NOLINTEND(*-magic-numbers)
+
+// func or func+0x1c
+template <> struct std::formatter<dzl::symbols::SymbolReference>
+{
+	constexpr auto parse(std::format_parse_context& t_context)
+	{
+		return t_context.begin();
+	}
+
+	[[nodiscard]] auto format(const dzl::symbols::SymbolReference& t_reference,
+							  std::format_context& t_context) const
+	{
+		if (t_reference.offset.get() == 0)
+		{
+			return std::format_to(t_context.out(), "{}", t_reference.name);
+		}
+		return std::format_to(t_context.out(), "{}+{:#x}", t_reference.name,
+							  t_reference.offset.get());
+	}
+};
@@ -0,0 +1,72 @@
+export module allocation_counter;
+
+import std;
+
+namespace dzl::memory
+{
+/*
+	Heap allocation accounting. The counters only move when the build installs the replacement
+	operator new/delete of allocation_hooks.cpp (ARM_DISASSEMBLER_COUNT_ALLOCATIONS), otherwise
+	every count stays zero.
+*/
+#if defined(ARM_DISASSEMBLER_COUNT_ALLOCATIONS)
+export constexpr bool allocation_counting{true};
+#else
+export constexpr bool allocation_counting{false};
+#endif
+
+// Attached to the global module so that the hooks, outside any module, can update them
+extern "C++"
+{
+	thread_local std::size_t thread_allocation_count{};
+	thread_local std::size_t thread_deallocation_count{};
+	thread_local std::size_t thread_allocated_bytes{};
+
+	std::atomic<std::size_t> process_allocation_count{};
+	std::atomic<std::size_t> process_deallocation_count{};
+	std::atomic<std::size_t> process_allocated_bytes{};
+}
+
+export struct AllocationCount
+{
+	std::size_t allocations;
+	std::size_t deallocations;
+	std::size_t bytes;
+
+	[[nodiscard]] constexpr auto operator-(const AllocationCount& t_earlier) const noexcept
+	{
+		return AllocationCount{.allocations = allocations - t_earlier.allocations,
+							   .deallocations = deallocations - t_earlier.deallocations,
+							   .bytes = bytes - t_earlier.bytes};
+	}
+
+	[[nodiscard]] constexpr auto operator==(const AllocationCount&) const noexcept -> bool = default;
+};
+
+// Allocations made by the calling thread so far
+export [[nodiscard]] auto thread_allocations() noexcept
+{
+	return AllocationCount{.allocations = thread_allocation_count,
+						   .deallocations = thread_deallocation_count,
+						   .bytes = thread_allocated_bytes};
+}
+
+// Allocations made by every thread so far
+export [[nodiscard]] auto process_allocations() noexcept
+{
+	return AllocationCount{.allocations = process_allocation_count.load(std::memory_order::relaxed),
+						   .deallocations =
+							   process_deallocation_count.load(std::memory_order::relaxed),
+						   .bytes = process_allocated_bytes.load(std::memory_order::relaxed)};
+}
+
+// Allocations made by the calling thread while running t_function
+export template <std::invocable Function>
+[[nodiscard]] auto count_allocations(Function&& t_function) -> AllocationCount
+{
+	const auto before{thread_allocations()};
+	std::invoke(std::forward<Function>(t_function));
+	return thread_allocations() - before;
+}
+
+} // namespace dzl::memory
@@ -0,0 +1,110 @@
+/*
+	Replacement global operator new/delete that count every allocation for the allocation_counter
+	module. Only built with ARM_DISASSEMBLER_COUNT_ALLOCATIONS.
+
+	The array and nothrow forms of the standard library forward to these.
+*/
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace dzl::memory
+{
+extern thread_local std::size_t thread_allocation_count;
+extern thread_local std::size_t thread_deallocation_count;
+extern thread_local std::size_t thread_allocated_bytes;
+
+extern std::atomic<std::size_t> process_allocation_count;
+extern std::atomic<std::size_t> process_deallocation_count;
+extern std::atomic<std::size_t> process_allocated_bytes;
+} // namespace dzl::memory
+
+namespace
+{
+auto count_allocation(const std::size_t t_size) noexcept -> void
+{
+	++dzl::memory::thread_allocation_count;
+	dzl::memory::thread_allocated_bytes += t_size;
+
+	dzl::memory::process_allocation_count.fetch_add(1, std::memory_order::relaxed);
+	dzl::memory::process_allocated_bytes.fetch_add(t_size, std::memory_order::relaxed);
+}
+
+auto count_deallocation() noexcept -> void
+{
+	++dzl::memory::thread_deallocation_count;
+	dzl::memory::process_deallocation_count.fetch_add(1, std::memory_order::relaxed);
+}
+
+} // namespace
+
+auto operator new(const std::size_t t_size) -> void*
+{
+	// Zero-sized allocations still return a unique pointer
+	auto* const pointer{std::malloc(t_size == 0 ? 1 : t_size)};
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	count_allocation(t_size);
+	return pointer;
+}
+
+auto operator new(const std::size_t t_size, const std::align_val_t t_alignment) -> void*
+{
+	const auto alignment{static_cast<std::size_t>(t_alignment)};
+	// aligned_alloc takes a multiple of the alignment
+	const auto rounded_size{((t_size + alignment - 1) / alignment) * alignment};
+
+#if defined(_WIN32)
+	auto* const pointer{_aligned_malloc(rounded_size == 0 ? alignment : rounded_size, alignment)};
+#else
+	auto* const pointer{std::aligned_alloc(alignment, rounded_size == 0 ? alignment : rounded_size)};
+#endif
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	count_allocation(t_size);
+	return pointer;
+}
+
+auto operator delete(void* const t_pointer) noexcept -> void
+{
+	if (t_pointer == nullptr)
+	{
+		return;
+	}
+
+	count_deallocation();
+	std::free(t_pointer);
+}
+
+auto operator delete(void* const t_pointer, std::align_val_t /*t_alignment*/) noexcept -> void
+{
+	if (t_pointer == nullptr)
+	{
+		return;
+	}
+
+	count_deallocation();
+#if defined(_WIN32)
+	_aligned_free(t_pointer);
+#else
+	std::free(t_pointer);
+#endif
+}
+
+auto operator delete(void* const t_pointer, std::size_t /*t_size*/) noexcept -> void
+{
+	::operator delete(t_pointer);
+}
+
+auto operator delete(void* const t_pointer, std::size_t /*t_size*/,
+					 const std::align_val_t t_alignment) noexcept -> void
+{
+	::operator delete(t_pointer, t_alignment);
+}
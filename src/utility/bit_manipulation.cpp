@@ -1,3 +1,9 @@
+module;
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 export module bit_manipulation;
 
 import std;
@@ -179,4 +185,438 @@ export template <UbChecked is_checked = UbChecked::Checked>
 	const BitShiftAmount shift_amount(t_width.get() - 1UZ);
 	const auto most_significant_bit{one << shift_amount};
 	return (masked ^ most_significant_bit) - most_significant_bit;
-}
\ No newline at end of file
+}
+
+/*
+	Vector kernels over 32-bit lanes. Each handles whole vectors only and returns how many values
+	it processed, the callers finish the remainder with the scalar operations.
+*/
+namespace simd
+{
+#if defined(__AVX2__)
+using Vector = __m256i;
+
+inline auto load(const std::byte* t_source)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t_source));
+}
+inline auto store(std::byte* t_destination, const Vector t_value)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(t_destination), t_value);
+}
+inline auto broadcast(const std::uint32_t t_value)
+{
+	return _mm256_set1_epi32(static_cast<int>(t_value));
+}
+inline auto shift_left(const Vector t_value, const std::size_t t_amount)
+{
+	return _mm256_sll_epi32(t_value, _mm_cvtsi32_si128(static_cast<int>(t_amount)));
+}
+inline auto shift_right(const Vector t_value, const std::size_t t_amount)
+{
+	return _mm256_srl_epi32(t_value, _mm_cvtsi32_si128(static_cast<int>(t_amount)));
+}
+inline auto bit_and(const Vector t_first, const Vector t_second)
+{
+	return _mm256_and_si256(t_first, t_second);
+}
+inline auto bit_or(const Vector t_first, const Vector t_second)
+{
+	return _mm256_or_si256(t_first, t_second);
+}
+inline auto bit_xor(const Vector t_first, const Vector t_second)
+{
+	return _mm256_xor_si256(t_first, t_second);
+}
+inline auto subtract(const Vector t_first, const Vector t_second)
+{
+	return _mm256_sub_epi32(t_first, t_second);
+}
+#elif defined(__SSE2__)
+using Vector = __m128i;
+
+inline auto load(const std::byte* t_source)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_source));
+}
+inline auto store(std::byte* t_destination, const Vector t_value)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(t_destination), t_value);
+}
+inline auto broadcast(const std::uint32_t t_value)
+{
+	return _mm_set1_epi32(static_cast<int>(t_value));
+}
+inline auto shift_left(const Vector t_value, const std::size_t t_amount)
+{
+	return _mm_sll_epi32(t_value, _mm_cvtsi32_si128(static_cast<int>(t_amount)));
+}
+inline auto shift_right(const Vector t_value, const std::size_t t_amount)
+{
+	return _mm_srl_epi32(t_value, _mm_cvtsi32_si128(static_cast<int>(t_amount)));
+}
+inline auto bit_and(const Vector t_first, const Vector t_second)
+{
+	return _mm_and_si128(t_first, t_second);
+}
+inline auto bit_or(const Vector t_first, const Vector t_second)
+{
+	return _mm_or_si128(t_first, t_second);
+}
+inline auto bit_xor(const Vector t_first, const Vector t_second)
+{
+	return _mm_xor_si128(t_first, t_second);
+}
+inline auto subtract(const Vector t_first, const Vector t_second)
+{
+	return _mm_sub_epi32(t_first, t_second);
+}
+#endif
+
+#if defined(__SSE2__)
+constexpr std::size_t lane_count{sizeof(Vector) / sizeof(std::uint32_t)};
+
+auto transform(const void* t_input, void* t_output, const std::size_t t_count,
+			   const auto& t_operation) -> std::size_t
+{
+	const auto* const input{static_cast<const std::byte*>(t_input)};
+	auto* const output{static_cast<std::byte*>(t_output)};
+
+	std::size_t i_value{};
+	for (; i_value + lane_count <= t_count; i_value += lane_count)
+	{
+		const auto offset{i_value * sizeof(std::uint32_t)};
+		store(output + offset, t_operation(load(input + offset)));
+	}
+	return i_value;
+}
+#endif
+
+auto get_bits([[maybe_unused]] const void* t_values, [[maybe_unused]] void* t_results,
+			  [[maybe_unused]] const std::size_t t_count, [[maybe_unused]] const std::size_t t_shift,
+			  [[maybe_unused]] const std::uint32_t t_mask) -> std::size_t
+{
+#if defined(__SSE2__)
+	const auto mask{broadcast(t_mask)};
+	return transform(t_values, t_results, t_count,
+					 [&](const Vector t_value) { return bit_and(shift_right(t_value, t_shift), mask); });
+#else
+	return 0;
+#endif
+}
+
+// Destinations are updated in place
+auto set_bits([[maybe_unused]] void* t_destinations, [[maybe_unused]] const void* t_sources,
+			  [[maybe_unused]] const std::size_t t_count,
+			  [[maybe_unused]] const std::uint32_t t_destination_mask,
+			  [[maybe_unused]] const std::uint32_t t_source_mask,
+			  [[maybe_unused]] const std::size_t t_shift) -> std::size_t
+{
+#if defined(__SSE2__)
+	const auto destination_mask{broadcast(t_destination_mask)};
+	const auto source_mask{broadcast(t_source_mask)};
+	const auto* const sources{static_cast<const std::byte*>(t_sources)};
+	auto* const destinations{static_cast<std::byte*>(t_destinations)};
+
+	std::size_t i_value{};
+	for (; i_value + lane_count <= t_count; i_value += lane_count)
+	{
+		const auto offset{i_value * sizeof(std::uint32_t)};
+		const auto kept{bit_and(load(destinations + offset), destination_mask)};
+		const auto inserted{shift_left(bit_and(load(sources + offset), source_mask), t_shift)};
+		store(destinations + offset, bit_or(kept, inserted));
+	}
+	return i_value;
+#else
+	return 0;
+#endif
+}
+
+auto sign_extend([[maybe_unused]] const void* t_values, [[maybe_unused]] void* t_results,
+				 [[maybe_unused]] const std::size_t t_count,
+				 [[maybe_unused]] const std::uint32_t t_mask,
+				 [[maybe_unused]] const std::uint32_t t_most_significant_bit) -> std::size_t
+{
+#if defined(__SSE2__)
+	const auto mask{broadcast(t_mask)};
+	const auto most_significant_bit{broadcast(t_most_significant_bit)};
+	return transform(t_values, t_results, t_count,
+					 [&](const Vector t_value)
+					 {
+						 const auto flipped{bit_xor(bit_and(t_value, mask), most_significant_bit)};
+						 return subtract(flipped, most_significant_bit);
+					 });
+#else
+	return 0;
+#endif
+}
+
+// t_amount must be less than 32, shifting a lane by 32 clears it
+auto rotate_right([[maybe_unused]] const void* t_values, [[maybe_unused]] void* t_results,
+				  [[maybe_unused]] const std::size_t t_count,
+				  [[maybe_unused]] const std::size_t t_amount) -> std::size_t
+{
+#if defined(__SSE2__)
+	return transform(t_values, t_results, t_count,
+					 [&](const Vector t_value)
+					 {
+						 return bit_or(shift_right(t_value, t_amount),
+									   shift_left(t_value, 32 - t_amount));
+					 });
+#else
+	return 0;
+#endif
+}
+
+// Per-value amounts need variable shifts, which only AVX2 has
+auto rotate_right([[maybe_unused]] const void* t_values,
+				  [[maybe_unused]] const void* t_amounts, [[maybe_unused]] void* t_results,
+				  [[maybe_unused]] const std::size_t t_count) -> std::size_t
+{
+#if defined(__AVX2__)
+	const auto* const values{static_cast<const std::byte*>(t_values)};
+	const auto* const amounts{static_cast<const std::byte*>(t_amounts)};
+	auto* const results{static_cast<std::byte*>(t_results)};
+	const auto amount_mask{broadcast(31)};
+	const auto lane_bits{broadcast(32)};
+
+	std::size_t i_value{};
+	for (; i_value + lane_count <= t_count; i_value += lane_count)
+	{
+		const auto offset{i_value * sizeof(std::uint32_t)};
+		const auto value{load(values + offset)};
+		const auto amount{bit_and(
+			_mm256_cvtepu8_epi32(
+				_mm_loadl_epi64(reinterpret_cast<const __m128i*>(amounts + i_value))),
+			amount_mask)};
+
+		store(results + offset,
+			  bit_or(_mm256_srlv_epi32(value, amount),
+					 _mm256_sllv_epi32(value, subtract(lane_bits, amount))));
+	}
+	return i_value;
+#else
+	return 0;
+#endif
+}
+
+} // namespace simd
+
+/*
+	Batch operations, applying one range, width or amount across arrays of values. Outputs must
+	hold at least as many values as the inputs.
+*/
+export template <typename Range>
+concept StrongUnsignedRange = std::ranges::contiguous_range<Range> &&
+							  std::ranges::sized_range<Range> &&
+							  StrongUnsigned<std::ranges::range_value_t<Range>>;
+
+export template <typename Range>
+concept BitShiftAmountRange = std::ranges::contiguous_range<Range> &&
+							  std::ranges::sized_range<Range> &&
+							  std::same_as<std::ranges::range_value_t<Range>, BitShiftAmount>;
+
+constexpr auto require_batch_output(const std::size_t t_input_size,
+									const std::size_t t_output_size) -> void
+{
+	if (t_output_size < t_input_size)
+	{
+		throw std::invalid_argument("Batch output is smaller than its input");
+	}
+}
+
+// If unchecked, t_range.m_begin and t_range.m_size must both be less than sizeof_bits<Type>
+export template <UbChecked is_checked = UbChecked::Checked, StrongUnsignedRange Input,
+				 StrongUnsignedRange Output>
+	requires std::same_as<std::ranges::range_value_t<Input>, std::ranges::range_value_t<Output>>
+constexpr auto get_bits(const Input& t_values, const BitRange t_range, Output&& t_results) -> void
+{
+	using ValueType = std::ranges::range_value_t<Input>;
+
+	const std::span values{t_values};
+	const std::span results{t_results};
+	require_batch_output(values.size(), results.size());
+
+	if constexpr (is_checked == UbChecked::Checked)
+	{
+		if (t_range.begin().get() >= sizeof_bits<ValueType>)
+		{
+			// Defined behaviour: return zero
+			constexpr static ValueType zero{0};
+			std::ranges::fill_n(results.begin(), static_cast<std::ptrdiff_t>(values.size()), zero);
+			return;
+		}
+	}
+
+	const auto mask{make_unshifted_bit_mask<sizeof(ValueType), is_checked>(t_range.size())};
+	const BitShiftAmount shift_amount(t_range.begin().get());
+
+	std::size_t i_value{};
+	if !consteval
+	{
+		if constexpr (sizeof(ValueType) == sizeof(std::uint32_t))
+		{
+			i_value = simd::get_bits(values.data(), results.data(), values.size(),
+									 t_range.begin().get(), mask.get());
+		}
+	}
+
+	for (; i_value < values.size(); ++i_value)
+	{
+		results[i_value] = (values[i_value] >> shift_amount) & mask;
+	}
+}
+
+// If unchecked, t_range.m_begin and t_range.m_size must both be less than sizeof_bits<Type>
+export template <UbChecked is_checked = UbChecked::Checked, StrongUnsignedRange Output,
+				 StrongUnsignedRange Input>
+	requires std::same_as<std::ranges::range_value_t<Input>, std::ranges::range_value_t<Output>>
+constexpr auto set_bits(Output&& t_destinations, const Input& t_sources, const BitRange t_range)
+	-> void
+{
+	using ValueType = std::ranges::range_value_t<Input>;
+
+	const std::span destinations{t_destinations};
+	const std::span sources{t_sources};
+	require_batch_output(sources.size(), destinations.size());
+
+	if constexpr (is_checked == UbChecked::Checked)
+	{
+		if (t_range.begin().get() >= sizeof_bits<ValueType>)
+		{
+			// Defined behaviour: leave the destinations unchanged
+			return;
+		}
+	}
+
+	const auto destination_mask{~(t_range.make_mask<sizeof(ValueType), is_checked>())};
+	const auto source_mask{make_unshifted_bit_mask<sizeof(ValueType), is_checked>(t_range.size())};
+	const BitShiftAmount shift_amount(t_range.begin().get());
+
+	std::size_t i_value{};
+	if !consteval
+	{
+		if constexpr (sizeof(ValueType) == sizeof(std::uint32_t))
+		{
+			i_value = simd::set_bits(destinations.data(), sources.data(), sources.size(),
+									 destination_mask.get(), source_mask.get(),
+									 t_range.begin().get());
+		}
+	}
+
+	for (; i_value < sources.size(); ++i_value)
+	{
+		destinations[i_value] = (destinations[i_value] & destination_mask) |
+								((sources[i_value] & source_mask) << shift_amount);
+	}
+}
+
+// If unchecked, t_width must be greater than zero and less than sizeof_bits<Type>
+export template <UbChecked is_checked = UbChecked::Checked, StrongUnsignedRange Input,
+				 StrongUnsignedRange Output>
+	requires std::same_as<std::ranges::range_value_t<Input>, std::ranges::range_value_t<Output>>
+constexpr auto sign_extend(const Input& t_values, const BitSize t_width, Output&& t_results) -> void
+{
+	using ValueType = std::ranges::range_value_t<Input>;
+
+	const std::span values{t_values};
+	const std::span results{t_results};
+	require_batch_output(values.size(), results.size());
+
+	if constexpr (is_checked == UbChecked::Checked)
+	{
+		if (t_width == 0_bs)
+		{
+			// Defined behaviour: return zero
+			constexpr static ValueType zero{0};
+			std::ranges::fill_n(results.begin(), static_cast<std::ptrdiff_t>(values.size()), zero);
+			return;
+		}
+
+		if (t_width.get() >= sizeof_bits<ValueType>)
+		{
+			// Defined behaviour: return the unchanged values
+			std::ranges::copy(values, results.begin());
+			return;
+		}
+	}
+
+	const auto mask{make_unshifted_bit_mask<sizeof(ValueType), is_checked>(t_width)};
+
+	constexpr static ValueType one{1};
+	const BitShiftAmount shift_amount(t_width.get() - 1UZ);
+	const auto most_significant_bit{one << shift_amount};
+
+	std::size_t i_value{};
+	if !consteval
+	{
+		if constexpr (sizeof(ValueType) == sizeof(std::uint32_t))
+		{
+			i_value = simd::sign_extend(values.data(), results.data(), values.size(), mask.get(),
+										most_significant_bit.get());
+		}
+	}
+
+	for (; i_value < values.size(); ++i_value)
+	{
+		results[i_value] = ((values[i_value] & mask) ^ most_significant_bit) - most_significant_bit;
+	}
+}
+
+// Every value rotated by the same amount
+export template <StrongUnsignedRange Input, StrongUnsignedRange Output>
+	requires std::same_as<std::ranges::range_value_t<Input>, std::ranges::range_value_t<Output>>
+constexpr auto rotate_right(const Input& t_values, const BitShiftAmount t_amount,
+							Output&& t_results) -> void
+{
+	using ValueType = std::ranges::range_value_t<Input>;
+
+	const std::span values{t_values};
+	const std::span results{t_results};
+	require_batch_output(values.size(), results.size());
+
+	std::size_t i_value{};
+	if !consteval
+	{
+		if constexpr (sizeof(ValueType) == sizeof(std::uint32_t))
+		{
+			i_value = simd::rotate_right(values.data(), results.data(), values.size(),
+										 t_amount.get() % sizeof_bits<ValueType>);
+		}
+	}
+
+	for (; i_value < values.size(); ++i_value)
+	{
+		results[i_value] = rotate_right(values[i_value], t_amount);
+	}
+}
+
+// Each value rotated by its own amount, such as the immediates of data processing operands
+export template <StrongUnsignedRange Input, BitShiftAmountRange Amounts, StrongUnsignedRange Output>
+	requires std::same_as<std::ranges::range_value_t<Input>, std::ranges::range_value_t<Output>>
+constexpr auto rotate_right(const Input& t_values, const Amounts& t_amounts, Output&& t_results)
+	-> void
+{
+	using ValueType = std::ranges::range_value_t<Input>;
+
+	const std::span values{t_values};
+	const std::span amounts{t_amounts};
+	const std::span results{t_results};
+	require_batch_output(values.size(), amounts.size());
+	require_batch_output(values.size(), results.size());
+
+	std::size_t i_value{};
+	if !consteval
+	{
+		if constexpr (sizeof(ValueType) == sizeof(std::uint32_t))
+		{
+			i_value = simd::rotate_right(values.data(), amounts.data(), results.data(),
+										 values.size());
+		}
+	}
+
+	for (; i_value < values.size(); ++i_value)
+	{
+		results[i_value] = rotate_right(values[i_value], amounts[i_value]);
+	}
+}
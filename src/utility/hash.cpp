@@ -0,0 +1,106 @@
+export module hash;
+
+import std;
+
+/*
+	XXH64 (https://github.com/Cyan4973/xxHash), reproduced bit-exactly
+*/
+
+// NOLINTBEGIN(*-magic-numbers)
+
+constexpr std::uint64_t prime_1{0x9E3779B1'85EBCA87};
+constexpr std::uint64_t prime_2{0xC2B2AE3D'27D4EB4F};
+constexpr std::uint64_t prime_3{0x165667B1'9E3779F9};
+constexpr std::uint64_t prime_4{0x85EBCA77'C2B2AE63};
+constexpr std::uint64_t prime_5{0x27D4EB2F'165667C5};
+
+template <std::unsigned_integral Type>
+[[nodiscard]] constexpr auto read_little_endian(const std::span<const std::byte> t_bytes) noexcept
+{
+	Type value{};
+	for (std::size_t i_byte{}; i_byte < sizeof(Type); ++i_byte)
+	{
+		value |= static_cast<Type>(static_cast<Type>(t_bytes[i_byte]) << (8U * i_byte));
+	}
+	return value;
+}
+
+[[nodiscard]] constexpr auto accumulate_round(std::uint64_t t_accumulator,
+												const std::uint64_t t_input) noexcept
+{
+	t_accumulator += t_input * prime_2;
+	t_accumulator = std::rotl(t_accumulator, 31);
+	return t_accumulator * prime_1;
+}
+
+[[nodiscard]] constexpr auto merge_round(const std::uint64_t t_accumulator,
+										 const std::uint64_t t_value) noexcept
+{
+	return ((t_accumulator ^ accumulate_round(0, t_value)) * prime_1) + prime_4;
+}
+
+export [[nodiscard]] constexpr auto xxhash64(std::span<const std::byte> t_bytes,
+											 const std::uint64_t t_seed = 0) noexcept
+{
+	const auto length{static_cast<std::uint64_t>(t_bytes.size())};
+	std::uint64_t hash{};
+
+	if (t_bytes.size() >= 32)
+	{
+		std::array accumulators{t_seed + prime_1 + prime_2, t_seed + prime_2, t_seed,
+								t_seed - prime_1};
+
+		while (t_bytes.size() >= 32)
+		{
+			for (std::size_t i_lane{}; i_lane < accumulators.size(); ++i_lane)
+			{
+				accumulators[i_lane] = accumulate_round(
+					accumulators[i_lane],
+					read_little_endian<std::uint64_t>(t_bytes.subspan(i_lane * 8)));
+			}
+			t_bytes = t_bytes.subspan(32);
+		}
+
+		hash = std::rotl(accumulators[0], 1) + std::rotl(accumulators[1], 7) +
+			   std::rotl(accumulators[2], 12) + std::rotl(accumulators[3], 18);
+		for (const auto accumulator : accumulators)
+		{
+			hash = merge_round(hash, accumulator);
+		}
+	}
+	else
+	{
+		hash = t_seed + prime_5;
+	}
+
+	hash += length;
+
+	while (t_bytes.size() >= 8)
+	{
+		hash ^= accumulate_round(0, read_little_endian<std::uint64_t>(t_bytes));
+		hash = (std::rotl(hash, 27) * prime_1) + prime_4;
+		t_bytes = t_bytes.subspan(8);
+	}
+
+	if (t_bytes.size() >= 4)
+	{
+		hash ^= read_little_endian<std::uint32_t>(t_bytes) * prime_1;
+		hash = (std::rotl(hash, 23) * prime_2) + prime_3;
+		t_bytes = t_bytes.subspan(4);
+	}
+
+	for (const auto byte : t_bytes)
+	{
+		hash ^= static_cast<std::uint64_t>(byte) * prime_5;
+		hash = std::rotl(hash, 11) * prime_1;
+	}
+
+	hash ^= hash >> 33U;
+	hash *= prime_2;
+	hash ^= hash >> 29U;
+	hash *= prime_3;
+	hash ^= hash >> 32U;
+	return hash;
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,73 @@
+export module lru_cache;
+
+import std;
+
+/*
+	Shared values by key, evicting the least recently used once their total size exceeds the
+	limit. The newest value always stays, even when larger than the limit alone. Not synchronised,
+	callers sharing a cache between threads lock around it.
+*/
+export template <typename Key, typename Value> class LruCache
+{
+public:
+	explicit LruCache(const std::size_t t_size_limit) : m_size_limit(t_size_limit) {}
+
+	// Marks the value as the most recently used
+	[[nodiscard]] auto find(const Key& t_key) -> std::shared_ptr<const Value>
+	{
+		const auto entry{m_entries.find(t_key)};
+		if (entry == m_entries.end())
+		{
+			return nullptr;
+		}
+
+		m_order.splice(m_order.begin(), m_order, entry->second.position);
+		return entry->second.value;
+	}
+
+	[[nodiscard]] auto contains(const Key& t_key) const { return m_entries.contains(t_key); }
+
+	// Keeps an existing value for the key, returning the number of values evicted
+	auto insert(const Key& t_key, std::shared_ptr<const Value> t_value, const std::size_t t_size)
+		-> std::size_t
+	{
+		if (m_entries.contains(t_key))
+		{
+			return 0;
+		}
+
+		m_size += t_size;
+		m_order.push_front(t_key);
+		m_entries.emplace(t_key, Entry{.value = std::move(t_value),
+									   .size = t_size,
+									   .position = m_order.begin()});
+
+		std::size_t evictions{};
+		while (m_size > m_size_limit && m_order.size() > 1)
+		{
+			const auto oldest{m_entries.find(m_order.back())};
+			m_size -= oldest->second.size;
+			m_entries.erase(oldest);
+			m_order.pop_back();
+			++evictions;
+		}
+		return evictions;
+	}
+
+	[[nodiscard]] auto size() const noexcept { return m_size; }
+	[[nodiscard]] auto count() const noexcept { return m_entries.size(); }
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<const Value> value;
+		std::size_t size;
+		typename std::list<Key>::iterator position;
+	};
+
+	std::size_t m_size_limit;
+	std::size_t m_size{};
+
+	std::unordered_map<Key, Entry> m_entries;
+	std::list<Key> m_order;
+};
@@ -0,0 +1,118 @@
+module;
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+export module mapped_file;
+
+import std;
+
+/*
+	Read-only view of a whole file, memory mapped where the platform allows it and read into
+	memory otherwise
+*/
+export class MappedFile
+{
+public:
+	explicit MappedFile(const std::filesystem::path& t_path)
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		const auto descriptor{::open(t_path.c_str(), O_RDONLY)};
+		if (descriptor < 0)
+		{
+			throw std::runtime_error(std::format("Cannot open {}", t_path.string()));
+		}
+
+		struct stat status{};
+		if (::fstat(descriptor, &status) != 0)
+		{
+			::close(descriptor);
+			throw std::runtime_error(std::format("Cannot stat {}", t_path.string()));
+		}
+
+		m_size = static_cast<std::size_t>(status.st_size);
+		if (m_size != 0)
+		{
+			void* const address{::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+			if (address == MAP_FAILED)
+			{
+				::close(descriptor);
+				throw std::runtime_error(std::format("Cannot map {}", t_path.string()));
+			}
+			m_data = static_cast<const std::byte*>(address);
+		}
+		::close(descriptor);
+#else
+		std::ifstream file(t_path, std::ios::binary);
+		if (!file)
+		{
+			throw std::runtime_error(std::format("Cannot open {}", t_path.string()));
+		}
+
+		m_buffer.resize(static_cast<std::size_t>(std::filesystem::file_size(t_path)));
+		file.read(reinterpret_cast<char*>(m_buffer.data()),
+				  static_cast<std::streamsize>(m_buffer.size()));
+		if (!file)
+		{
+			throw std::runtime_error(std::format("Cannot read {}", t_path.string()));
+		}
+
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+	MappedFile(MappedFile&& t_other) noexcept
+		: m_data(std::exchange(t_other.m_data, nullptr)), m_size(std::exchange(t_other.m_size, 0))
+#if !(defined(__unix__) || defined(__APPLE__))
+		  ,
+		  m_buffer(std::move(t_other.m_buffer))
+#endif
+	{
+	}
+
+	auto operator=(MappedFile&& t_other) noexcept -> MappedFile&
+	{
+		if (this != &t_other)
+		{
+			unmap();
+			m_data = std::exchange(t_other.m_data, nullptr);
+			m_size = std::exchange(t_other.m_size, 0);
+#if !(defined(__unix__) || defined(__APPLE__))
+			m_buffer = std::move(t_other.m_buffer);
+#endif
+		}
+		return *this;
+	}
+
+	~MappedFile() { unmap(); }
+
+	[[nodiscard]] auto bytes() const noexcept { return std::span(m_data, m_size); }
+
+private:
+	auto unmap() noexcept -> void
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		if (m_data != nullptr)
+		{
+			::munmap(const_cast<std::byte*>(m_data), m_size);
+		}
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	const std::byte* m_data{};
+	std::size_t m_size{};
+
+#if !(defined(__unix__) || defined(__APPLE__))
+	std::vector<std::byte> m_buffer;
+#endif
+};
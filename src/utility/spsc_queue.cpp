@@ -0,0 +1,56 @@
+export module spsc_queue;
+
+import std;
+
+/*
+	Bounded lock-free queue between exactly one producer thread and one consumer thread. Both
+	ends block (without spinning) while the queue is full or empty.
+*/
+export template <std::movable Type, std::size_t capacity> class SpscQueue
+{
+public:
+	static_assert(capacity > 0);
+
+	SpscQueue() = default;
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue(SpscQueue&&) = delete;
+	auto operator=(const SpscQueue&) -> SpscQueue& = delete;
+	auto operator=(SpscQueue&&) -> SpscQueue& = delete;
+	~SpscQueue() = default;
+
+	auto push(Type t_value) -> void
+	{
+		const auto tail{m_tail.load(std::memory_order::relaxed)};
+		for (auto head{m_head.load(std::memory_order::acquire)}; tail - head == capacity;
+			 head = m_head.load(std::memory_order::acquire))
+		{
+			m_head.wait(head, std::memory_order::acquire);
+		}
+
+		m_slots[tail % capacity] = std::move(t_value);
+		m_tail.store(tail + 1, std::memory_order::release);
+		m_tail.notify_one();
+	}
+
+	[[nodiscard]] auto pop() -> Type
+	{
+		const auto head{m_head.load(std::memory_order::relaxed)};
+		while (m_tail.load(std::memory_order::acquire) == head)
+		{
+			m_tail.wait(head, std::memory_order::acquire);
+		}
+
+		auto value{std::move(m_slots[head % capacity])};
+		m_head.store(head + 1, std::memory_order::release);
+		m_head.notify_one();
+		return value;
+	}
+
+private:
+	// Producer and consumer indices on separate cache lines
+	alignas(64) std::atomic<std::size_t> m_head{};
+	alignas(64) std::atomic<std::size_t> m_tail{};
+
+	std::array<Type, capacity> m_slots{};
+};
@@ -0,0 +1,118 @@
+export module text_arena;
+
+import std;
+
+/*
+	Monotonic arena for formatted text. Lines are appended back-to-back into fixed-size blocks and
+	returned as views that stay valid until reset(). A reset keeps every block, so refilling an
+	arena of the same size never allocates.
+*/
+export class TextArena
+{
+public:
+	constexpr static std::size_t default_block_size{1UZ << 20U};
+
+	TextArena() = default;
+
+	explicit TextArena(const std::size_t t_block_size) : m_block_size(t_block_size)
+	{
+		if (t_block_size == 0)
+		{
+			throw std::invalid_argument("Text arena blocks cannot be empty");
+		}
+	}
+
+	// Formats straight into the arena, a line never straddles two blocks
+	template <typename... Args>
+	auto format(const std::format_string<const Args&...> t_format, const Args&... t_arguments)
+		-> std::string_view
+	{
+		auto& block{m_active == 0 ? next_block(0) : m_blocks[m_active - 1]};
+		auto* const begin{block.data.get() + block.used};
+		const auto available{block.capacity - block.used};
+
+		const auto [end, size]{std::format_to_n(begin, static_cast<std::ptrdiff_t>(available),
+												t_format, t_arguments...)};
+		if (std::cmp_less_equal(size, available))
+		{
+			block.used += static_cast<std::size_t>(size);
+			return {begin, end};
+		}
+
+		// Formatted a second time, only when the current block is full
+		auto& next{next_block(static_cast<std::size_t>(size))};
+		std::format_to(next.data.get(), t_format, t_arguments...);
+		next.used = static_cast<std::size_t>(size);
+		return {next.data.get(), next.used};
+	}
+
+	auto append(const std::string_view t_text) -> std::string_view
+	{
+		auto* block{m_active == 0 ? &next_block(t_text.size()) : &m_blocks[m_active - 1]};
+		if (block->capacity - block->used < t_text.size())
+		{
+			block = &next_block(t_text.size());
+		}
+
+		auto* const begin{block->data.get() + block->used};
+		std::ranges::copy(t_text, begin);
+		block->used += t_text.size();
+		return {begin, t_text.size()};
+	}
+
+	// Invalidates every view handed out so far
+	auto reset() noexcept -> void
+	{
+		m_active = 0;
+	}
+
+	// Text of the blocks in use, in append order
+	[[nodiscard]] auto blocks() const
+	{
+		return m_blocks | std::views::take(m_active) |
+			   std::views::transform([](const Block& t_block)
+									 { return std::string_view(t_block.data.get(), t_block.used); });
+	}
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t
+	{
+		return std::ranges::fold_left(m_blocks | std::views::take(m_active), 0UZ,
+									  [](const std::size_t t_total, const Block& t_block)
+									  { return t_total + t_block.used; });
+	}
+
+	// Blocks allocated over the arena's lifetime, in use or not
+	[[nodiscard]] auto block_count() const noexcept -> std::size_t
+	{
+		return m_blocks.size();
+	}
+
+private:
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		std::size_t capacity{};
+		std::size_t used{};
+	};
+
+	// Reuses the next spare block when it is large enough, oversized text gets a block of its own
+	auto next_block(const std::size_t t_minimum_capacity) -> Block&
+	{
+		if (m_active == m_blocks.size() || m_blocks[m_active].capacity < t_minimum_capacity)
+		{
+			const auto capacity{std::max(m_block_size, t_minimum_capacity)};
+			m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(m_active),
+							Block{.data = std::make_unique_for_overwrite<char[]>(capacity),
+								  .capacity = capacity,
+								  .used = 0});
+		}
+
+		auto& block{m_blocks[m_active++]};
+		block.used = 0;
+		return block;
+	}
+
+	std::size_t m_block_size{default_block_size};
+	std::vector<Block> m_blocks;
+	std::size_t m_active{};
+};
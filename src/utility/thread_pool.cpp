@@ -0,0 +1,113 @@
+export module thread_pool;
+
+import std;
+
+/*
+	Fixed set of worker threads consuming jobs in submission order, except for jobs submitted to
+	run next
+*/
+export class ThreadPool
+{
+public:
+	explicit ThreadPool(const std::size_t t_thread_count)
+	{
+		const auto thread_count{std::max(t_thread_count, 1UZ)};
+
+		m_threads.reserve(thread_count);
+		for (std::size_t i_thread{}; i_thread < thread_count; ++i_thread)
+		{
+			m_threads.emplace_back([this](const std::stop_token t_stop_token) { work(t_stop_token); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+	auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+	~ThreadPool() = default;
+
+	[[nodiscard]] auto thread_count() const noexcept { return m_threads.size(); }
+
+	auto submit(std::move_only_function<void()> t_job) -> void
+	{
+		{
+			const std::scoped_lock lock(m_mutex);
+			m_jobs.push_back(std::move(t_job));
+			++m_pending;
+		}
+		m_job_available.notify_one();
+	}
+
+	// Ahead of the jobs already waiting, for follow-up work that should not queue behind them
+	auto submit_next(std::move_only_function<void()> t_job) -> void
+	{
+		{
+			const std::scoped_lock lock(m_mutex);
+			m_jobs.push_front(std::move(t_job));
+			++m_pending;
+		}
+		m_job_available.notify_one();
+	}
+
+	// Blocks until every submitted job has finished, rethrowing the first job exception
+	auto wait() -> void
+	{
+		std::unique_lock lock(m_mutex);
+		m_idle.wait(lock, [this] { return m_pending == 0; });
+
+		if (m_exception)
+		{
+			std::rethrow_exception(std::exchange(m_exception, nullptr));
+		}
+	}
+
+private:
+	auto work(const std::stop_token t_stop_token) -> void
+	{
+		while (true)
+		{
+			std::move_only_function<void()> job;
+			{
+				std::unique_lock lock(m_mutex);
+				if (!m_job_available.wait(lock, t_stop_token, [this] { return !m_jobs.empty(); }))
+				{
+					return;
+				}
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+
+			std::exception_ptr exception;
+			try
+			{
+				job();
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+
+			{
+				const std::scoped_lock lock(m_mutex);
+				if (exception && !m_exception)
+				{
+					m_exception = exception;
+				}
+				--m_pending;
+			}
+			m_idle.notify_all();
+		}
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_job_available;
+	std::condition_variable m_idle;
+
+	std::deque<std::move_only_function<void()>> m_jobs;
+	std::size_t m_pending{};
+	std::exception_ptr m_exception;
+
+	// Declared last so that the workers are joined before the state above is destroyed
+	std::vector<std::jthread> m_threads;
+};
@@ -0,0 +1,183 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "armdis.h"
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+// Words as the C interface takes them, with the text disassemble() gives for them
+struct Image
+{
+	std::vector<std::uint32_t> words;
+	std::string text;
+};
+
+auto make_image(const std::size_t t_count) -> Image
+{
+	const auto words{dzl::test::make_instructions(t_count)};
+
+	Image image;
+	for (const auto word : words)
+	{
+		image.words.push_back(word.get());
+	}
+	dzl::disassemble(words, image.text);
+	return image;
+}
+} // namespace
+
+TEST_CASE("Decoding then formatting matches disassemble()", "[armdis::armdis_format]")
+{
+	const auto image{make_image(100)};
+
+	std::vector<armdis_insn> instructions(image.words.size());
+	REQUIRE(armdis_decode(image.words.data(), image.words.size(), instructions.data()) ==
+			ARMDIS_OK);
+	REQUIRE(std::ranges::all_of(instructions, [](const armdis_insn& t_instruction)
+								{ return t_instruction.decoded != 0; }));
+	REQUIRE(instructions[3].word == image.words[3]);
+
+	std::string text(image.text.size() + 1, 'x');
+	std::size_t written{};
+	REQUIRE(armdis_format(instructions.data(), instructions.size(), text.data(), text.size(),
+						  &written) == ARMDIS_OK);
+	REQUIRE(written == image.text.size());
+	REQUIRE(text[written] == '\0');
+	REQUIRE(text.substr(0, written) == image.text);
+
+	std::ranges::fill(text, 'x');
+	REQUIRE(armdis_disassemble(image.words.data(), image.words.size(), text.data(), text.size(),
+							   &written) == ARMDIS_OK);
+	REQUIRE(written == image.text.size());
+	REQUIRE(text[written] == '\0');
+	REQUIRE(text.substr(0, written) == image.text);
+}
+
+TEST_CASE("Buffers without room for the terminator report the length needed",
+		  "[armdis::armdis_disassemble]")
+{
+	const auto image{make_image(20)};
+
+	std::size_t written{};
+	REQUIRE(armdis_disassemble(image.words.data(), image.words.size(), nullptr, 0, &written) ==
+			ARMDIS_BUFFER_TOO_SMALL);
+	REQUIRE(written == image.text.size());
+
+	std::string text(image.text.size(), 'x');
+	REQUIRE(armdis_disassemble(image.words.data(), image.words.size(), text.data(), text.size(),
+							   &written) == ARMDIS_BUFFER_TOO_SMALL);
+	REQUIRE(written == image.text.size());
+
+	std::vector<armdis_insn> instructions(image.words.size());
+	REQUIRE(armdis_decode(image.words.data(), image.words.size(), instructions.data()) ==
+			ARMDIS_OK);
+	REQUIRE(armdis_format(instructions.data(), instructions.size(), text.data(), text.size(),
+						  &written) == ARMDIS_BUFFER_TOO_SMALL);
+	REQUIRE(written == image.text.size());
+
+	// Repeated with the length reported
+	text.resize(written + 1);
+	REQUIRE(armdis_format(instructions.data(), instructions.size(), text.data(), text.size(),
+						  &written) == ARMDIS_OK);
+	REQUIRE(text.substr(0, written) == image.text);
+}
+
+TEST_CASE("No words give empty text", "[armdis::armdis_disassemble]")
+{
+	std::array buffer{'x'};
+	std::size_t written{1};
+
+	REQUIRE(armdis_decode(nullptr, 0, nullptr) == ARMDIS_OK);
+
+	REQUIRE(armdis_format(nullptr, 0, buffer.data(), buffer.size(), &written) == ARMDIS_OK);
+	REQUIRE(written == 0);
+	REQUIRE(buffer[0] == '\0');
+
+	buffer[0] = 'x';
+	written = 1;
+	REQUIRE(armdis_disassemble(nullptr, 0, buffer.data(), buffer.size(), &written) == ARMDIS_OK);
+	REQUIRE(written == 0);
+	REQUIRE(buffer[0] == '\0');
+
+	// Even empty text needs room for its terminator
+	REQUIRE(armdis_disassemble(nullptr, 0, nullptr, 0, &written) == ARMDIS_BUFFER_TOO_SMALL);
+	REQUIRE(written == 0);
+}
+
+TEST_CASE("Null arguments are rejected", "[armdis::armdis_decode]")
+{
+	const std::uint32_t word{0xE3A0'0001};
+	armdis_insn instruction{};
+	std::array<char, 64> buffer{};
+	std::size_t written{};
+
+	REQUIRE(armdis_decode(nullptr, 1, &instruction) == ARMDIS_INVALID_ARGUMENT);
+	REQUIRE(armdis_decode(&word, 1, nullptr) == ARMDIS_INVALID_ARGUMENT);
+
+	REQUIRE(armdis_format(nullptr, 1, buffer.data(), buffer.size(), &written) ==
+			ARMDIS_INVALID_ARGUMENT);
+	REQUIRE(armdis_format(&instruction, 1, nullptr, buffer.size(), &written) ==
+			ARMDIS_INVALID_ARGUMENT);
+	REQUIRE(armdis_format(&instruction, 1, buffer.data(), buffer.size(), nullptr) ==
+			ARMDIS_INVALID_ARGUMENT);
+
+	REQUIRE(armdis_disassemble(nullptr, 1, buffer.data(), buffer.size(), &written) ==
+			ARMDIS_INVALID_ARGUMENT);
+	REQUIRE(armdis_disassemble(&word, 1, nullptr, buffer.size(), &written) ==
+			ARMDIS_INVALID_ARGUMENT);
+	REQUIRE(armdis_disassemble(&word, 1, buffer.data(), buffer.size(), nullptr) ==
+			ARMDIS_INVALID_ARGUMENT);
+
+	REQUIRE(std::string_view(armdis_status_string(ARMDIS_INVALID_ARGUMENT)) ==
+			"invalid argument");
+	REQUIRE(std::string_view(armdis_status_string(ARMDIS_BUFFER_TOO_SMALL)) ==
+			"buffer too small");
+}
+
+TEST_CASE("Instructions that do not match their word are rejected", "[armdis::armdis_format]")
+{
+	const std::array words{0xE3A0'0001U, 0xE12F'FF1EU};
+	std::array<armdis_insn, 2> instructions{};
+	REQUIRE(armdis_decode(words.data(), words.size(), instructions.data()) == ARMDIS_OK);
+
+	std::array<char, 256> buffer{};
+	std::size_t written{};
+	REQUIRE(armdis_format(instructions.data(), instructions.size(), buffer.data(), buffer.size(),
+						  &written) == ARMDIS_OK);
+
+	// An operation past the last one, and the bits of another instruction
+	auto corrupted{instructions};
+	corrupted[1].bits = (corrupted[1].bits & ~0xFFULL) | 0xFFU;
+	REQUIRE(armdis_format(corrupted.data(), corrupted.size(), buffer.data(), buffer.size(),
+						  &written) == ARMDIS_INVALID_ARGUMENT);
+
+	corrupted = instructions;
+	corrupted[1].bits = instructions[0].bits;
+	REQUIRE(armdis_format(corrupted.data(), corrupted.size(), buffer.data(), buffer.size(),
+						  &written) == ARMDIS_INVALID_ARGUMENT);
+
+	// A word claimed to decode that does not
+	corrupted = instructions;
+	corrupted[0].word = 0xE7F0'00F0U;
+	REQUIRE(armdis_format(corrupted.data(), corrupted.size(), buffer.data(), buffer.size(),
+						  &written) == ARMDIS_INVALID_ARGUMENT);
+
+	// Words not claimed to decode are data whatever their bits
+	corrupted = instructions;
+	corrupted[0].decoded = 0;
+	corrupted[0].bits = ~0ULL;
+	REQUIRE(armdis_format(corrupted.data(), corrupted.size(), buffer.data(), buffer.size(),
+						  &written) == ARMDIS_OK);
+	REQUIRE(std::string_view(buffer.data(), written).starts_with(".word 0xe3a00001\n"));
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+import batch;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+auto write_words(const std::filesystem::path& t_path, const std::span<const dzl::Word> t_words)
+{
+	std::ofstream file(t_path, std::ios::binary);
+	file.write(reinterpret_cast<const char*>(t_words.data()),
+			   static_cast<std::streamsize>(t_words.size_bytes()));
+}
+
+auto read_text(const std::filesystem::path& t_path)
+{
+	std::ifstream file(t_path, std::ios::binary);
+	return std::string{std::istreambuf_iterator<char>(file), {}};
+}
+
+} // namespace
+
+TEST_CASE("Manifest entries are listed inside the output directory", "[batch::collect_inputs]")
+{
+	const auto manifest{dzl::test::temporary_path("batch_manifest.txt")};
+	const auto collect{[&](const std::string_view t_lines)
+					   {
+						   std::ofstream(manifest) << t_lines;
+						   return dzl::batch::collect_inputs(manifest);
+					   }};
+
+	const auto inputs{collect("/images/a.bin\nimages/./b/../c.bin\n\n")};
+	REQUIRE(inputs.size() == 2);
+	REQUIRE(inputs[0].output == "images/a.bin");
+	REQUIRE(inputs[1].output == "images/c.bin");
+
+	REQUIRE_THROWS_AS(collect("../../x.bin\n"), std::runtime_error);
+	REQUIRE_THROWS_AS(collect("a/../../x.bin\n"), std::runtime_error);
+
+	// Both would be listed to a/x.bin.s
+	REQUIRE_THROWS_AS(collect("/a/x.bin\na/x.bin\n"), std::runtime_error);
+
+	std::filesystem::remove(manifest);
+}
+
+TEST_CASE("Files are listed whole and failures do not stop the others", "[batch::run]")
+{
+	const auto directory{dzl::test::temporary_path("batch")};
+	std::filesystem::create_directories(directory / "input");
+
+	// Past the first chunk, with literals loaded across its end in both directions
+	constexpr std::size_t chunk_word_count{1UZ << 18U};
+	std::vector<dzl::Word> large(chunk_word_count + 16, 0xE3A0'0001_u32);
+	large[chunk_word_count - 2] = 0xE59F'0000_u32; // ldr r0, [pc]
+	large[chunk_word_count] = 0xE3A0'0002_u32;
+	large[chunk_word_count + 8] = 0xE51F'0040_u32; // ldr r0, [pc, #-64]
+	large[chunk_word_count - 6] = 0xE3A0'0003_u32;
+	const std::array small{0xE081'1002_u32, 0xE12F'FF1E_u32};
+
+	write_words(directory / "input" / "large.bin", large);
+	write_words(directory / "input" / "small.bin", small);
+
+	auto inputs{dzl::batch::collect_inputs(directory / "input")};
+	REQUIRE(inputs.size() == 2);
+	inputs.push_back({.path = directory / "input" / "missing.bin", .output = "missing.bin"});
+
+	const auto reports{dzl::batch::run(inputs, directory / "output", std::endian::native, 4)};
+	REQUIRE(reports.size() == 3);
+
+	for (const auto& report : reports)
+	{
+		const auto name{report.input.filename()};
+		if (name == "missing.bin")
+		{
+			REQUIRE(!report.error.empty());
+			REQUIRE(!std::filesystem::exists(directory / "output" / "missing.bin.s"));
+			continue;
+		}
+
+		REQUIRE(report.error.empty());
+		std::string expected;
+		dzl::disassemble(name == "large.bin" ? std::span<const dzl::Word>(large)
+											 : std::span<const dzl::Word>(small),
+						 expected);
+
+		auto listing_name{name};
+		listing_name += ".s";
+		REQUIRE(read_text(directory / "output" / listing_name) == expected);
+	}
+
+	std::filesystem::remove_all(directory);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import data_classifier;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::search::WordKind;
+
+TEST_CASE("Literal pools, invalid words and conditional runs are data", "[search::classify]")
+{
+	std::vector<dzl::Word> words{
+		0xE59F'0004_u32, // ldr r0, [pc, #4]
+		0xE59F'1004_u32, // ldr r1, [pc, #4]
+		0xE12F'FF1E_u32, // bx lr
+		0x0000'1234_u32, // Literal
+		0x0000'BEEF_u32, // Literal
+		0xE7F0'00F0_u32, // Undefined
+		0xF000'0000_u32, // Never condition
+		0xE1A0'0000_u32, // mov r0, r0
+	};
+
+	// A table of small constants, then a tail too short to judge
+	for (std::uint32_t i_word{}; i_word < 10U; ++i_word)
+	{
+		words.emplace_back(i_word);
+	}
+
+	const auto kinds{dzl::search::classify(words)};
+	REQUIRE(kinds.size() == words.size());
+
+	REQUIRE(kinds[0] == WordKind::Code);
+	REQUIRE(kinds[1] == WordKind::Code);
+	REQUIRE(kinds[2] == WordKind::Code);
+	REQUIRE(kinds[3] == WordKind::Literal);
+	REQUIRE(kinds[4] == WordKind::Literal);
+	REQUIRE(kinds[5] == WordKind::Invalid);
+	REQUIRE(kinds[6] == WordKind::Invalid);
+	REQUIRE(kinds[7] == WordKind::Code);
+
+	for (std::size_t i_word{8}; i_word < 16; ++i_word)
+	{
+		REQUIRE(kinds[i_word] == WordKind::Unlikely);
+	}
+	REQUIRE(kinds[16] == WordKind::Code);
+	REQUIRE(kinds[17] == WordKind::Code);
+}
+
+TEST_CASE("Loads from data and loads leaving the image mark nothing", "[search::classify]")
+{
+	const std::array words{
+		0xF59F'0000_u32, // ldr with the never condition
+		0xE51F'0010_u32, // ldr r0, [pc, #-16]
+		0xE59F'0FFF_u32, // ldr r0, [pc, #4095]
+		0xE1A0'0000_u32, // mov r0, r0
+	};
+
+	const auto kinds{dzl::search::classify(words)};
+	REQUIRE(kinds[0] == WordKind::Invalid);
+	REQUIRE(kinds[1] == WordKind::Code);
+	REQUIRE(kinds[2] == WordKind::Code);
+	REQUIRE(kinds[3] == WordKind::Code);
+}
+
+TEST_CASE("Streamed chunks are classified as the whole image", "[search::StreamingClassifier]")
+{
+	// Mostly code, with pc-relative loads reaching across chunks in both directions
+	std::mt19937 generator(1729);
+	std::vector<dzl::Word> words(20'000);
+	for (auto& word : words)
+	{
+		const auto offset{generator() % 4096};
+		switch (generator() % 6)
+		{
+		case 0:
+			word = dzl::Word(0xE59F'0000U | offset); // ldr r0, [pc, #offset]
+			break;
+		case 1:
+			word = dzl::Word(0xE51F'0000U | offset); // ldr r0, [pc, #-offset]
+			break;
+		case 2:
+			word = dzl::Word(static_cast<std::uint32_t>(generator()));
+			break;
+		default:
+			word = 0xE081'1002_u32; // add r1, r1, r2
+		}
+	}
+	const auto expected{dzl::search::classify(words)};
+
+	for (const auto chunk_size : {8UZ, 1000UZ, 4096UZ, 20'000UZ})
+	{
+		dzl::search::StreamingClassifier classifier;
+		std::vector<WordKind> kinds;
+		const auto take_final{[&]
+							  {
+								  const auto count{classifier.final_count() - kinds.size()};
+								  const auto final_kinds{classifier.kinds(kinds.size(), count)};
+								  kinds.insert(kinds.end(), final_kinds.begin(), final_kinds.end());
+								  classifier.release(kinds.size());
+							  }};
+
+		for (std::size_t i_word{}; i_word < words.size(); i_word += chunk_size)
+		{
+			classifier.push(
+				std::span(words).subspan(i_word, std::min(chunk_size, words.size() - i_word)));
+			take_final();
+		}
+		classifier.finish();
+		take_final();
+
+		REQUIRE(kinds == expected);
+	}
+
+	// Only the last chunk may end inside a window
+	dzl::search::StreamingClassifier classifier;
+	classifier.push(std::span(words).first(5));
+	REQUIRE_THROWS_AS(classifier.push(std::span(words).first(8)), std::logic_error);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import arm_instruction;
+import def_use;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::Register;
+
+namespace
+{
+[[nodiscard]] constexpr auto def_use_of(const dzl::Word t_word)
+{
+	return dzl::def_use(dzl::fmt::arm::decode(t_word));
+}
+
+[[nodiscard]] constexpr auto mask(const std::initializer_list<Register> t_registers)
+{
+	std::uint32_t result{};
+	for (const auto register_ : t_registers)
+	{
+		result |= dzl::register_mask(register_);
+	}
+	return result;
+}
+} // namespace
+
+TEST_CASE("Data processing reads its operands and writes its destination", "[def_use]")
+{
+	using enum Register;
+
+	// add r1, r0, r2
+	STATIC_REQUIRE(def_use_of(0xE080'1002_u32) == dzl::DefUse{mask({R0, R2}), mask({R1})});
+	// adds r1, r1, r2
+	STATIC_REQUIRE(def_use_of(0xE091'1002_u32) == dzl::DefUse{mask({R1, R2}), mask({R1, Cpsr})});
+	// cmp r1, #0x3fc
+	STATIC_REQUIRE(def_use_of(0xE351'0FFF_u32) == dzl::DefUse{mask({R1}), mask({Cpsr})});
+	// adc r0, r0, #1
+	STATIC_REQUIRE(def_use_of(0xE2A0'0001_u32) == dzl::DefUse{mask({R0, Cpsr}), mask({R0})});
+	// movne r0, r1, rrx
+	STATIC_REQUIRE(def_use_of(0x11A0'0061_u32) == dzl::DefUse{mask({R1, Cpsr}), mask({R0})});
+	// mov r0, r1, lsl r2
+	STATIC_REQUIRE(def_use_of(0xE1A0'0211_u32) == dzl::DefUse{mask({R1, R2}), mask({R0})});
+}
+
+TEST_CASE("Branches, status moves and multiplies report implicit registers", "[def_use]")
+{
+	using enum Register;
+
+	// bl
+	STATIC_REQUIRE(def_use_of(0xEB00'0000_u32) == dzl::DefUse{mask({Pc}), mask({Pc, Lr})});
+	// bx lr
+	STATIC_REQUIRE(def_use_of(0xE12F'FF1E_u32) == dzl::DefUse{mask({Lr}), mask({Pc})});
+	// mrs r0, cpsr
+	STATIC_REQUIRE(def_use_of(0xE10F'0000_u32) == dzl::DefUse{mask({Cpsr}), mask({R0})});
+	// msr cpsr_f, r0
+	STATIC_REQUIRE(def_use_of(0xE128'F000_u32) == dzl::DefUse{mask({R0}), mask({Cpsr})});
+}
+
+TEST_CASE("Multiplies read the accumulator and write both long halves", "[def_use]")
+{
+	using enum Register;
+	using dzl::ins::Operation;
+
+	// Multiplies are not decoded yet, so are built directly
+	constexpr auto multiply{[](const bool t_accumulate, const bool t_is_long)
+							{
+								return dzl::def_use(dzl::ins::Instruction(dzl::ins::Multiply(
+									Operation::Multiply, dzl::Condition::Al, R1, R0, R2, R3, false,
+									t_accumulate, t_is_long, true)));
+							}};
+
+	STATIC_REQUIRE(multiply(false, false) == dzl::DefUse{mask({R2, R3}), mask({R1})});
+	STATIC_REQUIRE(multiply(true, false) == dzl::DefUse{mask({R0, R2, R3}), mask({R1})});
+	STATIC_REQUIRE(multiply(false, true) == dzl::DefUse{mask({R2, R3}), mask({R0, R1})});
+	STATIC_REQUIRE(multiply(true, true) == dzl::DefUse{mask({R0, R1, R2, R3}), mask({R0, R1})});
+}
+
+TEST_CASE("The batch version matches the single lookups", "[def_use]")
+{
+	const std::array words{0xE080'1002_u32, 0xEB00'0000_u32, 0xE10F'0000_u32};
+
+	std::vector<dzl::ins::Instruction> instructions;
+	for (const auto word : words)
+	{
+		instructions.push_back(dzl::fmt::arm::decode(word));
+	}
+
+	std::vector<dzl::DefUse> results(instructions.size());
+	dzl::def_use(instructions, results);
+	for (std::size_t i_instruction{}; i_instruction < instructions.size(); ++i_instruction)
+	{
+		REQUIRE(results[i_instruction] == dzl::def_use(instructions[i_instruction]));
+	}
+
+	std::vector<dzl::DefUse> too_small(1);
+	REQUIRE_THROWS_AS(dzl::def_use(instructions, too_small), std::invalid_argument);
+}
+
+// NOLINTEND(*-magic-numbers)
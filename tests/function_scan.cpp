@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import function_scan;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Functions start at prologues and call targets and end at epilogues",
+		  "[search::find_functions]")
+{
+	const std::array words{
+		0xE92D'4010_u32, // 0x8000: stmfd sp!, {r4, lr}
+		0xEB00'0003_u32, // 0x8004: bl 0x8018
+		0xE8BD'8010_u32, // 0x8008: ldmfd sp!, {r4, pc}
+		0xE1A0'0000_u32, // 0x800c: mov r0, r0
+		0xE52D'E004_u32, // 0x8010: str lr, [sp, #-4]!
+		0xE49D'F004_u32, // 0x8014: ldr pc, [sp], #4
+		0xE3A0'0000_u32, // 0x8018: mov r0, #0
+		0xE12F'FF1E_u32, // 0x801c: bx lr
+		0xEBFF'FFF6_u32, // 0x8020: bl 0x8000
+		0xE1A0'F00E_u32, // 0x8024: mov pc, lr
+	};
+
+	const auto functions{dzl::search::find_functions(words, 0x8000_add)};
+	REQUIRE(functions.size() == 3);
+
+	REQUIRE(functions[0].start == 0x8000_add);
+	REQUIRE(functions[0].end == 0x800C_add);
+	REQUIRE(functions[0].has_prologue);
+	REQUIRE(functions[0].is_call_target);
+
+	REQUIRE(functions[1].start == 0x8010_add);
+	REQUIRE(functions[1].end == 0x8018_add);
+	REQUIRE(functions[1].has_prologue);
+	REQUIRE(!functions[1].is_call_target);
+
+	REQUIRE(functions[2].start == 0x8018_add);
+	REQUIRE(functions[2].end == 0x8020_add);
+	REQUIRE(!functions[2].has_prologue);
+	REQUIRE(functions[2].is_call_target);
+
+	REQUIRE(dzl::search::function_name(functions[2]) == "sub_00008018");
+}
+
+TEST_CASE("Calls leaving the image are not function starts", "[search::find_functions]")
+{
+	// bl 0x7f00, then bl 0x9004
+	const std::array words{0xEBFF'FFBE_u32, 0xEB00'03FE_u32};
+	REQUIRE(dzl::search::find_functions(words, 0x8000_add).empty());
+}
+
+// NOLINTEND(*-magic-numbers)
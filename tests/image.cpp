@@ -0,0 +1,36 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import image;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Words of the foreign byte order are swapped in place", "[io::to_native]")
+{
+	constexpr auto foreign{std::endian::native == std::endian::little ? std::endian::big
+																	   : std::endian::little};
+
+	// Long enough to cover the vectorised loops and the scalar tail
+	std::vector<dzl::Word> words;
+	for (std::uint32_t i_word{}; i_word < 19U; ++i_word)
+	{
+		words.emplace_back(0x0102'0300U + i_word);
+	}
+
+	auto converted{words};
+	dzl::io::to_native(converted, foreign);
+	for (std::size_t i_word{}; i_word < words.size(); ++i_word)
+	{
+		REQUIRE(converted[i_word].get() == std::byteswap(words[i_word].get()));
+	}
+
+	auto unchanged{words};
+	dzl::io::to_native(unchanged, std::endian::native);
+	REQUIRE(unchanged == words);
+}
+
+// NOLINTEND(*-magic-numbers)
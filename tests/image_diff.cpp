@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import image_diff;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::diff::Change;
+
+namespace
+{
+[[nodiscard]] auto make_image()
+{
+	std::vector<dzl::Word> words;
+	for (std::uint32_t i_function{}; i_function < 6U; ++i_function)
+	{
+		words.push_back(0xE92D'4010_u32);				 // stmfd sp!, {r4, lr}
+		words.emplace_back(0xE3A0'0000U + i_function); // mov r0, #i_function
+		words.push_back(0xE280'0001_u32);				 // add r0, r0, #1
+		words.emplace_back(0xEB00'0000U + i_function); // bl
+		words.push_back(0xE8BD'8010_u32);				 // ldmfd sp!, {r4, pc}
+	}
+	return words;
+}
+} // namespace
+
+TEST_CASE("Moved branch and literal offsets are not changes", "[diff::diff]")
+{
+	const auto old_words{make_image()};
+
+	auto new_words{old_words};
+	new_words[3] = 0xEB00'0100_u32;
+	new_words[8] = 0xEBFF'FFF0_u32;
+
+	REQUIRE(dzl::diff::normalize(0xE59F'0004_u32) == dzl::diff::normalize(0xE51F'0100_u32));
+	REQUIRE(dzl::diff::diff(old_words, new_words).empty());
+}
+
+TEST_CASE("Insertions, deletions and replacements are reported word by word", "[diff::diff]")
+{
+	const auto old_words{make_image()};
+
+	auto new_words{old_words};
+	new_words.insert(new_words.begin() + 7, 0xE1A0'0000_u32);
+	new_words[13] = 0xE280'0002_u32;
+	new_words.erase(new_words.begin() + 20, new_words.begin() + 25);
+
+	const auto changes{dzl::diff::diff(old_words, new_words)};
+	REQUIRE(changes == std::vector<Change>{{7, 0, 7, 1}, {12, 1, 13, 1}, {20, 5, 21, 0}});
+}
+
+// NOLINTEND(*-magic-numbers)
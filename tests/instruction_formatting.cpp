@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import shift_operand;
+import arm_instruction;
+import instruction_formatting;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::Register;
+using dzl::ShiftOperand;
+using dzl::ShiftType;
+
+TEST_CASE("Shift operands are formatted from their precomputed text",
+		  "[std::formatter<ShiftOperand>]")
+{
+	REQUIRE(std::format("{}", ShiftOperand(dzl::ImmediateValue(0x3FC))) == "#0x3fc");
+	REQUIRE(std::format("{}", ShiftOperand(dzl::Byte(0xFF), 30_sh)) == "#0x3fc");
+	REQUIRE(std::format("{}", ShiftOperand(dzl::Byte(0xFF), 8_sh)) == "#0xff000000");
+	REQUIRE(std::format("{}", ShiftOperand(Register::R3, ShiftType::LogicalLeft, 2_sh)) ==
+			"r3, lsl #2");
+	REQUIRE(std::format("{}", ShiftOperand(Register::R3, ShiftType::LogicalLeft, 0_sh)) == "r3");
+	REQUIRE(std::format("{}", ShiftOperand(Register::R1, ShiftType::RotateRightExtended, 0_sh)) ==
+			"r1, rrx");
+	REQUIRE(std::format("{}", ShiftOperand(Register::R10, ShiftType::ArithmeticRight,
+										   Register::R12)) == "r10, asr r12");
+
+	// Formatted within the rest of the output
+	REQUIRE(std::format("[{}] [{}]", ShiftOperand(Register::Pc, ShiftType::LogicalRight, 31_sh),
+						ShiftOperand(dzl::ImmediateValue(0))) == "[pc, lsr #31] [#0x0]");
+}
+
+TEST_CASE("Format specifications pad the text like a string", "[std::formatter<ShiftOperand>]")
+{
+	const ShiftOperand operand(Register::R3, ShiftType::LogicalLeft, 2_sh);
+	REQUIRE(std::format("[{:<14}]", operand) == "[r3, lsl #2    ]");
+	REQUIRE(std::format("[{:>14}]", operand) == "[    r3, lsl #2]");
+	REQUIRE(std::format("[{:*^14}]", operand) == "[**r3, lsl #2**]");
+	REQUIRE(std::format("[{:4}]", operand) == "[r3, lsl #2]");
+	REQUIRE(std::format("[{:.2}]", operand) == "[r3]");
+	REQUIRE(std::format("[{:}]", operand) == "[r3, lsl #2]");
+
+	// Whole instructions, as listings align them
+	const auto instruction{dzl::fmt::arm::try_decode(0xE12F'FF1E_u32)};
+	REQUIRE(instruction.has_value());
+	REQUIRE(std::format("{:<10}|", *instruction) == "bx lr     |");
+	REQUIRE(std::format("{}|", *instruction) == "bx lr|");
+}
+
+TEST_CASE("Every decodable shift operand has text", "[std::formatter<ShiftOperand>]")
+{
+	std::size_t without_text{};
+	for (std::uint32_t i_bits{}; i_bits <= 0xFFFF; ++i_bits)
+	{
+		const ShiftOperand shift_operand(dzl::Unsigned<2>(static_cast<std::uint16_t>(i_bits)));
+		const auto text{std::format("{}", shift_operand)};
+		REQUIRE(text.size() <= 15);
+		without_text += text.empty() ? 1 : 0;
+	}
+
+	// Immediate shifts of types past rrx, 2^11 patterns for each of 3 types
+	REQUIRE(without_text == 3 * (1UZ << 11U));
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction_index;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+[[nodiscard]] auto run_query(const dzl::index::InstructionIndex& t_index,
+							 const std::vector<std::string_view>& t_terms)
+{
+	return t_index.query(dzl::index::parse_query(t_terms));
+}
+} // namespace
+
+TEST_CASE("Indexed instructions are found by their keys", "[index::InstructionIndex]")
+{
+	const std::array words{
+		0xE3A0'0001_u32, // mov r0, #1
+		0xE080'1002_u32, // add r1, r0, r2
+		0xE351'0FFF_u32, // cmp r1, #0x3fc
+		0xE12F'FF1E_u32, // bx lr
+		0x1AFF'FFFB_u32, // bne
+	};
+
+	const auto path{std::filesystem::temp_directory_path() / "dzl_instruction_index_test.idx"};
+	dzl::index::build_index(words, 0x8000_add, path);
+
+	{
+		const dzl::index::InstructionIndex index(path);
+		REQUIRE(index.base() == 0x8000_add);
+		REQUIRE(index.word_count() == words.size());
+
+		using Indices = std::vector<std::uint32_t>;
+		REQUIRE(run_query(index, {"op:mov"}) == Indices{0});
+		REQUIRE(run_query(index, {"imm:1"}) == Indices{0});
+		REQUIRE(run_query(index, {"read:r0"}) == Indices{1});
+		REQUIRE(run_query(index, {"write:r1"}) == Indices{1});
+		REQUIRE(run_query(index, {"imm:0x3fc"}) == Indices{2});
+		REQUIRE(run_query(index, {"read:lr"}) == Indices{3});
+		REQUIRE(run_query(index, {"cond:ne"}) == Indices{4});
+		REQUIRE(run_query(index, {"operation:bx|operation:b"}) == Indices{3, 4});
+		REQUIRE(run_query(index, {"write:pc", "cond:al"}) == Indices{3});
+		REQUIRE(run_query(index, {"op:sub"}).empty());
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupt key counts are rejected", "[index::InstructionIndex]")
+{
+	const std::array words{0xE3A0'0001_u32, 0xE12F'FF1E_u32};
+	const auto path{std::filesystem::temp_directory_path() / "dzl_instruction_index_corrupt.idx"};
+
+	// Counts whose size in bytes wraps around to zero or just past the file
+	for (const auto key_count : {std::uint64_t{1} << 62U, std::uint64_t{1} << 63U,
+								 std::numeric_limits<std::uint64_t>::max(), std::uint64_t{1000}})
+	{
+		dzl::index::build_index(words, 0x8000_add, path);
+		{
+			// The key count follows the magic, version, base address and word count
+			std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(24);
+			file.write(reinterpret_cast<const char*>(&key_count), sizeof(key_count));
+		}
+
+		REQUIRE_THROWS_AS(dzl::index::InstructionIndex(path), std::runtime_error);
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Malformed query terms are rejected", "[index::parse_query]")
+{
+	const auto parse{[](const std::string_view t_term)
+					 {
+						 const std::array terms{t_term};
+						 return dzl::index::parse_query(terms);
+					 }};
+
+	REQUIRE(parse("read:r13|read:sp").front().size() == 2);
+	REQUIRE_THROWS_AS(parse("mov"), std::invalid_argument);
+	REQUIRE_THROWS_AS(parse("op:nop"), std::invalid_argument);
+	REQUIRE_THROWS_AS(parse("imm:0xZZ"), std::invalid_argument);
+	REQUIRE_THROWS_AS(parse("colour:red"), std::invalid_argument);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import instruction;
+import instruction_views;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+constexpr std::array words{
+	0xE3A0'0001_u32, // mov r0, #0x1
+	0xE12F'FF1E_u32, // bx lr
+	0xE7F0'00F0_u32, // Undefined
+};
+} // namespace
+
+TEST_CASE("Decoded views are random access and lazy", "[views::decode]")
+{
+	const auto decoded{std::span(words).first(2) | dzl::views::decode};
+	STATIC_REQUIRE(std::ranges::random_access_range<decltype(decoded)>);
+
+	REQUIRE(decoded.size() == 2);
+	REQUIRE(decoded[1].get_operation() == dzl::ins::Operation::BranchAndExchange);
+
+	// Undecodable words only matter once accessed
+	const auto all{std::span(words) | dzl::views::try_decode};
+	REQUIRE(all[0].has_value());
+	REQUIRE(!all[2].has_value());
+}
+
+TEST_CASE("Formatted views render words and instructions", "[views::format]")
+{
+	const auto lines{std::span(words) | dzl::views::format};
+	REQUIRE(lines[0] == "mov r0, #0x1");
+	REQUIRE(lines[1] == "bx lr");
+	REQUIRE(lines[2] == ".word 0xe7f000f0");
+
+	const auto decoded_lines{std::span(words).first(2) | dzl::views::decode |
+							 dzl::views::format};
+	REQUIRE(std::ranges::equal(decoded_lines, std::array{"mov r0, #0x1", "bx lr"}));
+}
+
+TEST_CASE("Byte spans are assembled in either byte order", "[views::words]")
+{
+	constexpr std::array bytes{std::byte{0x1E}, std::byte{0xFF}, std::byte{0x2F}, std::byte{0xE1},
+							   std::byte{0xE1}, std::byte{0x2F}, std::byte{0xFF}, std::byte{0x1E},
+							   std::byte{0x00}};
+
+	const auto little{dzl::views::words(std::span(bytes).first(4), std::endian::little)};
+	const auto big{dzl::views::words(std::span(bytes).subspan(4), std::endian::big)};
+
+	REQUIRE(little.size() == 1);
+	REQUIRE(big.size() == 1);
+	REQUIRE(little[0] == 0xE12F'FF1E_u32);
+	REQUIRE(big[0] == 0xE12F'FF1E_u32);
+	REQUIRE((little | dzl::views::format)[0] == "bx lr");
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+import bit_manipulation;
+
+import types;
+import shift_operand;
+import interpreter;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::Register;
+using dzl::ShiftType;
+using dzl::Word;
+
+TEST_CASE("Shift operands produce the barrel shifter carry", "[emu::evaluate]")
+{
+	dzl::emu::RegisterFile registers{};
+	registers[1] = 0x8000'0001_u32;
+	registers[2] = 33_u32;
+
+	{
+		const dzl::ShiftOperand operand(Register::R1, ShiftType::RotateRightExtended, 0_sh);
+		const auto [value, carry]{dzl::emu::evaluate(operand, registers, true)};
+		REQUIRE(value == 0xC000'0000_u32);
+		REQUIRE(carry);
+	}
+	{
+		const dzl::ShiftOperand operand(Register::R1, ShiftType::LogicalRight, 32_sh);
+		const auto [value, carry]{dzl::emu::evaluate(operand, registers, false)};
+		REQUIRE(value == 0_u32);
+		REQUIRE(carry);
+	}
+	{
+		const dzl::ShiftOperand operand(Register::R1, ShiftType::LogicalLeft, Register::R2);
+		const auto [value, carry]{dzl::emu::evaluate(operand, registers, true)};
+		REQUIRE(value == 0_u32);
+		REQUIRE_FALSE(carry);
+	}
+	{
+		const dzl::ShiftOperand operand(dzl::Byte(0xFF), 30_sh);
+		const auto [value, carry]{dzl::emu::evaluate(operand, registers, false)};
+		REQUIRE(value == 0x3FC_u32);
+		REQUIRE_FALSE(carry);
+	}
+}
+
+TEST_CASE("A counting loop runs to completion", "[emu::Interpreter::run]")
+{
+	const std::array program{
+		0xE3A00005_u32, // mov r0, #5
+		0xE3A01000_u32, // mov r1, #0
+		0xE0811000_u32, // add r1, r1, r0
+		0xE2500001_u32, // subs r0, r0, #1
+		0x1AFFFFFC_u32, // bne 0x8008
+		0xEAFFFFFE_u32	// b 0x8014
+	};
+
+	dzl::emu::Interpreter interpreter(dzl::emu::Memory(0x8000_add, program));
+	interpreter.set_register(Register::Pc, 0x8000_u32);
+
+	const auto executed{interpreter.run(1000, 0x8014_add)};
+	REQUIRE(executed == 17);
+	REQUIRE(interpreter.get_register(Register::R0) == 0_u32);
+	REQUIRE(interpreter.get_register(Register::R1) == 15_u32);
+	REQUIRE(interpreter.get_register(Register::Pc) == 0x8014_u32);
+	REQUIRE(get_bit(interpreter.get_register(Register::Cpsr), 30_bi));
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import data_classifier;
+import symbol_table;
+import listing;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+auto list(const std::span<const dzl::Word> t_words, const dzl::listing::Options& t_options = {})
+{
+	std::string text;
+	dzl::listing::list(t_words, dzl::Address(0x8000U), t_options, text);
+	return text;
+}
+
+} // namespace
+
+TEST_CASE("Words are written as eight lowercase hexadecimal digits", "[listing::write_hex]")
+{
+	std::array<char, 8> digits{};
+	std::mt19937 generator(1729);
+
+	for (const auto value : {0x0000'0000U, 0xFFFF'FFFFU, 0x0123'4567U, 0x89AB'CDEFU})
+	{
+		REQUIRE(dzl::listing::write_hex(dzl::Word(value), digits.data()) ==
+				digits.data() + digits.size());
+		REQUIRE(std::string_view(digits.data(), digits.size()) == std::format("{:08x}", value));
+	}
+
+	for (std::size_t i_value{}; i_value < 1000; ++i_value)
+	{
+		const auto value{static_cast<std::uint32_t>(generator())};
+		static_cast<void>(dzl::listing::write_hex(dzl::Word(value), digits.data()));
+		REQUIRE(std::string_view(digits.data(), digits.size()) == std::format("{:08x}", value));
+	}
+}
+
+TEST_CASE("Lines have an address, word and instruction column", "[listing::list]")
+{
+	const std::array words{
+		0xE3A0'0001_u32, // mov r0, #0x1
+		0xE081'1002_u32, // add r1, r1, r2
+		0xE12F'FF1E_u32, // bx lr
+		0xF000'0000_u32, // Never condition
+	};
+
+	REQUIRE(list(words) == "00008000:  e3a00001  mov     r0, #0x1\n"
+						   "00008004:  e0811002  add     r1, r1, r2\n"
+						   "00008008:  e12fff1e  bx      lr\n"
+						   "0000800c:  f0000000  .word   0xf0000000\n");
+}
+
+TEST_CASE("Branches are annotated with their target on request", "[listing::list]")
+{
+	const std::array words{
+		0xE1A0'0000_u32, // mov r0, r0
+		0xEB00'0004_u32, // bl, 16 bytes past the pc
+		0xEAFF'FFFE_u32, // b, to itself
+	};
+
+	REQUIRE(list(words) == "00008000:  e1a00000  mov     r0, r0\n"
+						   "00008004:  eb000004  bl      0x10\n"
+						   "00008008:  eafffffe  b       -0x8\n");
+
+	REQUIRE(list(words, {.branch_targets = true}) ==
+			"00008000:  e1a00000  mov     r0, r0\n"
+			"00008004:  eb000004  bl      0x10  ; 0000801c\n"
+			"00008008:  eafffffe  b       -0x8  ; 00008008\n");
+}
+
+TEST_CASE("Branch targets are named after the symbol at or before them", "[listing::list]")
+{
+	const std::array symbols{
+		dzl::symbols::Symbol{.address = dzl::Address(0x8000U), .name = "main"},
+		dzl::symbols::Symbol{.address = dzl::Address(0x8010U), .name = "helper"},
+	};
+	const dzl::symbols::SymbolTable table(symbols);
+
+	const std::array words{
+		0xE1A0'0000_u32, // mov r0, r0
+		0xEB00'0004_u32, // bl helper+0xc
+		0xEAFF'FFFC_u32, // b main
+		0xEAFF'FFF7_u32, // b, before the first symbol
+	};
+
+	REQUIRE(list(words, {.symbols = &table}) ==
+			"00008000:  e1a00000  mov     r0, r0\n"
+			"00008004:  eb000004  bl      0x10  ; 0000801c <helper+0xc>\n"
+			"00008008:  eafffffc  b       -0x10  ; 00008000 <main>\n"
+			"0000800c:  eafffff7  b       -0x24  ; 00007ff0\n");
+}
+
+TEST_CASE("Listings append to the existing text", "[listing::list]")
+{
+	std::string text{"header\n"};
+	dzl::listing::list(std::array{0xE1A0'0000_u32}, dzl::Address(0xFFFF'FFFCU), {}, text);
+
+	REQUIRE(text == "header\n"
+					"fffffffc:  e1a00000  mov     r0, r0\n");
+}
+
+TEST_CASE("Slices listed with the kinds of the whole image match the whole listing",
+		  "[listing::list]")
+{
+	std::vector<dzl::Word> words(16, 0xE3A0'0001_u32); // mov r0, #0x1
+	words[6] = 0xE59F'0004_u32;						   // ldr r0, [pc, #4] of word 9
+
+	const auto whole{list(words)};
+	REQUIRE(whole.contains("00008024:  e3a00001  .word   0xe3a00001\n"));
+
+	// The literal is in the second slice, its load in the first
+	const auto kinds{dzl::search::classify(words)};
+	std::string slices;
+	dzl::listing::list(std::span(words).first(8), std::span(kinds).first(8), 0x8000_add, {},
+					   slices);
+	dzl::listing::list(std::span(words).subspan(8), std::span(kinds).subspan(8), 0x8020_add, {},
+					   slices);
+	REQUIRE(slices == whole);
+}
+
+// NOLINTEND(*-magic-numbers)
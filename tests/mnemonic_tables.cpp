@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+import types;
+import instruction;
+import mnemonic_tables;
+
+using dzl::Condition;
+using dzl::ins::DataProcessingOpCode;
+
+TEST_CASE("Data processing prefixes combine op code, condition and flags",
+		  "[mnemonic::data_processing]")
+{
+	STATIC_REQUIRE(dzl::mnemonic::data_processing(DataProcessingOpCode::Add, Condition::Al,
+												  false) == "add");
+	STATIC_REQUIRE(dzl::mnemonic::data_processing(DataProcessingOpCode::Add, Condition::Eq,
+												  true) == "addeqs");
+	STATIC_REQUIRE(dzl::mnemonic::data_processing(DataProcessingOpCode::Mvn, Condition::Le,
+												  true) == "mvnles");
+
+	// Comparisons never take the flag suffix
+	STATIC_REQUIRE(dzl::mnemonic::data_processing(DataProcessingOpCode::Cmp, Condition::Ne,
+												  true) == "cmpne");
+	STATIC_REQUIRE(dzl::mnemonic::data_processing(DataProcessingOpCode::Tst, Condition::Al,
+												  true) == "tst");
+}
+
+TEST_CASE("Multiply prefixes distinguish every variant", "[mnemonic::multiply]")
+{
+	STATIC_REQUIRE(dzl::mnemonic::multiply(false, false, false, Condition::Al, false) == "mul");
+	STATIC_REQUIRE(dzl::mnemonic::multiply(false, true, true, Condition::Gt, true) == "mlagts");
+	STATIC_REQUIRE(dzl::mnemonic::multiply(true, false, false, Condition::Al, false) == "smull");
+	STATIC_REQUIRE(dzl::mnemonic::multiply(true, true, true, Condition::Eq, true) == "umlaleqs");
+}
+
+TEST_CASE("Branch and PSR transfer prefixes", "[mnemonic::branch, mnemonic::move_to_psr]")
+{
+	STATIC_REQUIRE(dzl::mnemonic::branch(false, Condition::Al) == "b");
+	STATIC_REQUIRE(dzl::mnemonic::branch(true, Condition::Ne) == "blne");
+	STATIC_REQUIRE(dzl::mnemonic::branch_and_exchange(Condition::Cs) == "bxcs");
+	STATIC_REQUIRE(dzl::mnemonic::move_from_psr(Condition::Al) == "mrs");
+	STATIC_REQUIRE(dzl::mnemonic::move_to_psr(Condition::Mi) == "msrmi");
+}
@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "test_support.hpp"
+
+import std;
+
+import output_sink;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+constexpr std::size_t buffer_size{256UZ * 1024UZ};
+
+auto make_text(const std::size_t t_size)
+{
+	std::string text(t_size, ' ');
+	for (std::size_t i_char{}; i_char < t_size; ++i_char)
+	{
+		text[i_char] = i_char % 64 == 63 ? '\n' : static_cast<char>('a' + (i_char % 26));
+	}
+	return text;
+}
+
+auto write_pieces(dzl::io::OutputSink& t_sink, const std::string_view t_text,
+				  const std::size_t t_piece_size)
+{
+	for (std::size_t i_char{}; i_char < t_text.size(); i_char += t_piece_size)
+	{
+		t_sink.write(t_text.substr(i_char, t_piece_size));
+	}
+	t_sink.flush();
+}
+
+// Through a pipe read t_read_size bytes at a time, so that the writer waits on the reader
+auto write_to_pipe(const std::string_view t_text, const std::size_t t_piece_size,
+				   const std::size_t t_read_size)
+{
+	dzl::test::PipeReader pipe(t_read_size);
+	dzl::io::OutputSink sink(pipe.descriptor());
+	write_pieces(sink, t_text, t_piece_size);
+	return pipe.finish();
+}
+
+auto write_to_file(const std::string_view t_text, const std::size_t t_piece_size)
+{
+	std::string path{(std::filesystem::temp_directory_path() / "dzl_output_sink_XXXXXX").string()};
+	const auto descriptor{::mkstemp(path.data())};
+	REQUIRE(descriptor >= 0);
+
+	{
+		dzl::io::OutputSink sink(descriptor);
+		write_pieces(sink, t_text, t_piece_size);
+		REQUIRE(sink.statistics().bytes == t_text.size());
+	}
+	::close(descriptor);
+
+	std::ifstream file(path, std::ios::binary);
+	std::string output{std::istreambuf_iterator<char>(file), {}};
+	std::filesystem::remove(path);
+	return output;
+}
+
+} // namespace
+
+TEST_CASE("Output of whole buffers is written in full", "[io::OutputSink]")
+{
+	// Up to and past a batch of buffers, which used to lose the last full buffers
+	for (std::size_t i_buffers{1}; i_buffers <= 9; ++i_buffers)
+	{
+		const auto text{make_text(i_buffers * buffer_size)};
+		REQUIRE(write_to_pipe(text, text.size(), 65536) == text);
+		REQUIRE(write_to_file(text, text.size()) == text);
+	}
+}
+
+TEST_CASE("Odd sized writes and slow readers lose nothing", "[io::OutputSink]")
+{
+	for (const auto size : {0UZ, 1UZ, buffer_size - 1, buffer_size + 1, (4 * buffer_size) + 17,
+							(9 * buffer_size) - 5})
+	{
+		const auto text{make_text(size)};
+		for (const auto piece_size : {7UZ, 4093UZ, 1'000'003UZ})
+		{
+			REQUIRE(write_to_pipe(text, piece_size, 4093) == text);
+			REQUIRE(write_to_file(text, piece_size) == text);
+		}
+	}
+}
+
+TEST_CASE("Repeated small flushes to a slow reader lose nothing", "[io::OutputSink]")
+{
+	// Each flush used to splice a partly filled buffer, and the ring refilled buffers the pipe
+	// still referenced
+	dzl::test::PipeReader pipe(4093);
+	std::string expected;
+	{
+		dzl::io::OutputSink sink(pipe.descriptor());
+		for (std::size_t i_line{}; i_line < 20'000; ++i_line)
+		{
+			const auto line{std::format("{} {}\n", i_line, std::string(i_line % 300, 'x'))};
+			expected += line;
+			sink.write(line);
+			sink.flush();
+		}
+	}
+	REQUIRE(pipe.finish() == expected);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,156 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+import listing;
+import paged_view;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::test::lines;
+using dzl::views::PagedView;
+
+namespace
+{
+auto address(const std::size_t t_word) -> dzl::Address
+{
+	return 0x8000_add + dzl::AddressOffset(static_cast<std::uint32_t>(4 * t_word));
+}
+} // namespace
+
+TEST_CASE("Windows match the output of the whole image", "[views::PagedView]")
+{
+	const auto words{dzl::test::make_instructions(1000)};
+	std::string plain;
+	dzl::disassemble(words, plain);
+	std::string listing;
+	dzl::listing::list(words, 0x8000_add, {}, listing);
+
+	PagedView view(words, 0x8000_add, {.page_word_count = 128, .prefetch = false});
+	PagedView listing_view(words, 0x8000_add,
+						   {.page_word_count = 128,
+							.prefetch = false,
+							.listing = dzl::listing::Options{}});
+	REQUIRE(view.page_count() == 8);
+
+	// Within a page, across several and cut short by the end of the image
+	for (const auto [first, count] : {std::pair{0UZ, 10UZ}, std::pair{100UZ, 300UZ},
+									  std::pair{990UZ, 100UZ}})
+	{
+		REQUIRE(view.lines(address(first), count) == lines(plain, first, count));
+		REQUIRE(listing_view.lines(address(first), count) == lines(listing, first, count));
+	}
+
+	REQUIRE_THROWS_AS(view.lines(0x7FFC_add, 1), std::out_of_range);
+	REQUIRE_THROWS_AS(view.lines(address(1000), 1), std::out_of_range);
+	REQUIRE_THROWS_AS(view.page(8), std::out_of_range);
+}
+
+TEST_CASE("Pages are formatted once and evicted least recently used first", "[views::PagedView]")
+{
+	const auto words{dzl::test::make_instructions(1000)};
+	PagedView view(words, 0x8000_add, {.page_word_count = 100, .cache_size = 1, .prefetch = false});
+
+	const auto page{view.page(0)};
+	REQUIRE(page->line_count() == 100);
+	REQUIRE(view.page(0) == page);
+
+	// The cache only fits one page
+	static_cast<void>(view.page(1));
+	REQUIRE(view.page(0) != page);
+
+	const auto statistics{view.statistics()};
+	REQUIRE(statistics.hits == 1);
+	REQUIRE(statistics.misses == 3);
+	REQUIRE(statistics.evictions == 2);
+	REQUIRE(statistics.prefetched == 0);
+}
+
+TEST_CASE("Neighbouring pages are prefetched", "[views::PagedView]")
+{
+	const auto words{dzl::test::make_instructions(1000)};
+	PagedView view(words, 0x8000_add, {.page_word_count = 100});
+
+	static_cast<void>(view.page(5));
+	view.wait_for_prefetch();
+	REQUIRE(view.statistics().prefetched == 2);
+
+	static_cast<void>(view.page(4));
+	static_cast<void>(view.page(6));
+	const auto statistics{view.statistics()};
+	REQUIRE(statistics.hits == 2);
+	REQUIRE(statistics.misses == 1);
+}
+
+TEST_CASE("Mapped images of either byte order are paged", "[views::PagedView]")
+{
+	const auto words{dzl::test::make_instructions(300)};
+	std::string plain;
+	dzl::disassemble(words, plain);
+
+	constexpr auto foreign{std::endian::native == std::endian::little ? std::endian::big
+																	   : std::endian::little};
+	const auto path{dzl::test::temporary_path("paged_view_test.bin")};
+	{
+		std::vector<std::uint32_t> swapped;
+		for (const auto word : words)
+		{
+			swapped.push_back(std::byteswap(word.get()));
+		}
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(swapped.data()),
+				   static_cast<std::streamsize>(swapped.size() * sizeof(std::uint32_t)));
+	}
+
+	{
+		PagedView view(path, 0x8000_add, foreign, {.page_word_count = 64});
+		REQUIRE(view.word_count() == words.size());
+		REQUIRE(view.lines(address(0), words.size()) == plain);
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Literals loaded from another page are data", "[views::PagedView]")
+{
+	// Loads across pages and the blocks a foreign image is classified in, ahead and behind
+	auto words{dzl::test::make_instructions(70'000)};
+	words[65'530] = 0xE59F'0040_u32; // ldr r0, [pc, #0x40]
+	words[65'540] = 0xE51F'0020_u32; // ldr r0, [pc, #-0x20]
+	std::string plain;
+	dzl::disassemble(words, plain);
+	REQUIRE(lines(plain, 65'548, 1) == ".word 0xeb000004\n");
+	REQUIRE(lines(plain, 65'534, 1) == ".word 0xe12fff1e\n");
+
+	PagedView view(words, 0x8000_add, {.page_word_count = 16, .prefetch = false});
+	REQUIRE(view.lines(address(65'500), 100) == lines(plain, 65'500, 100));
+
+	constexpr auto foreign{std::endian::native == std::endian::little ? std::endian::big
+																	   : std::endian::little};
+	const auto path{dzl::test::temporary_path("paged_view_literals.bin")};
+	{
+		std::vector<std::uint32_t> swapped;
+		for (const auto word : words)
+		{
+			swapped.push_back(std::byteswap(word.get()));
+		}
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(swapped.data()),
+				   static_cast<std::streamsize>(swapped.size() * sizeof(std::uint32_t)));
+	}
+
+	{
+		PagedView mapped(path, 0x8000_add, foreign, {.page_word_count = 16, .prefetch = false});
+		REQUIRE(mapped.lines(address(0), words.size()) == plain);
+	}
+
+	std::filesystem::remove(path);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import arm_instruction;
+import pattern_search;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Patterns are parsed by name or as mask and value", "[search::parse_pattern]")
+{
+	REQUIRE(dzl::search::parse_pattern("pc-write").size() == 8);
+
+	const auto patterns{dzl::search::parse_pattern("0x0fffffff:0x012fff1e")};
+	REQUIRE(patterns.size() == 1);
+	REQUIRE(patterns[0].checked_bits == 0x0FFF'FFFF_u32);
+	REQUIRE(patterns[0].required_bits == 0x012F'FF1E_u32);
+
+	REQUIRE_THROWS_AS(dzl::search::parse_pattern("0x0f:0xf0"), std::invalid_argument);
+	REQUIRE_THROWS_AS(dzl::search::parse_pattern("unknown"), std::invalid_argument);
+}
+
+TEST_CASE("Matches are found in full blocks and in the tail", "[search::find_matches]")
+{
+	// Zero words would match a pattern that checks nothing, so padding must not be reported
+	std::vector<dzl::Word> words(19, 0xE1A0'0000_u32);
+	words[3] = 0xE12F'FF1E_u32;	 // bx lr
+	words[9] = 0xEB00'0010_u32;	 // bl
+	words[17] = 0x012F'FF1E_u32; // bxeq lr
+
+	const auto patterns{dzl::search::parse_pattern("bx-lr")};
+	const auto matches{dzl::search::find_matches(words, patterns)};
+	REQUIRE(matches.size() == 2);
+	REQUIRE(matches[0].index == 3);
+	REQUIRE(matches[1].index == 17);
+
+	const std::array everything{dzl::fmt::arm::FormatMask{.checked_bits = 0_u32,
+														  .required_bits = 0_u32}};
+	REQUIRE(dzl::search::find_matches(words, everything).size() == words.size());
+}
+
+TEST_CASE("Only instructions writing the pc match pc-write", "[search::find_matches]")
+{
+	const std::vector writes{
+		0xE1A0'F00E_u32, // mov pc, lr
+		0xE08F'F100_u32, // add pc, pc, r0, lsl #2
+		0xE1A0'F110_u32, // mov pc, r0, lsl r1
+		0xE25E'F004_u32, // subs pc, lr, #4
+		0xE3C0'F001_u32, // bic pc, r0, #1
+		0xE49D'F004_u32, // ldr pc, [sp], #4
+		0xE8BD'8000_u32, // pop {pc}
+	};
+	const std::vector others{
+		0xE12F'FF1E_u32, // bx lr
+		0xE350'F000_u32, // cmp r0, #0 with an Rd field of 15
+		0xE110'F001_u32, // tst r0, r1 with an Rd field of 15
+		0xE10F'F000_u32, // mrs with an Rd field of 15
+		0xE020'F291_u32, // mla with an Rn field of 15
+		0xE1C0'F0B0_u32, // strh with an Rd field of 15
+		0xE3A0'0001_u32, // mov r0, #0x1
+	};
+
+	const auto patterns{dzl::search::parse_pattern("pc-write")};
+	std::vector<dzl::Word> words(others.begin(), others.end());
+	words.insert(words.end(), writes.begin(), writes.end());
+
+	const auto matches{dzl::search::find_matches(words, patterns)};
+	REQUIRE(matches.size() == writes.size());
+	for (std::size_t i_match{}; i_match < matches.size(); ++i_match)
+	{
+		REQUIRE(matches[i_match].index == others.size() + i_match);
+	}
+}
+
+// NOLINTEND(*-magic-numbers)
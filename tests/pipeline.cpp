@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+import output_sink;
+import pipeline;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Pipelined output matches the disassembly of the whole image", "[pipeline::run]")
+{
+	// Two chunks and a bit, with literals loaded across the first chunk boundary both ways
+	constexpr std::size_t chunk_word_count{1UZ << 16U};
+	std::vector<dzl::Word> words((2 * chunk_word_count) + 100, 0xE3A0'0001_u32);
+	words[chunk_word_count - 6] = 0xE59F'0028_u32; // ldr r0, [pc, #40]
+	words[chunk_word_count + 6] = 0xE3A0'0002_u32;
+	words[chunk_word_count + 4] = 0xE51F'0028_u32; // ldr r0, [pc, #-40]
+	words[chunk_word_count - 4] = 0xE3A0'0003_u32;
+
+	std::string expected;
+	dzl::disassemble(words, expected);
+	REQUIRE(expected.contains(".word 0xe3a00002\n"));
+	REQUIRE(expected.contains(".word 0xe3a00003\n"));
+
+	const auto path{dzl::test::temporary_path("pipeline_test.bin")};
+	{
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(words.data()),
+				   static_cast<std::streamsize>(words.size() * sizeof(dzl::Word)));
+	}
+
+	dzl::test::PipeReader pipe;
+	dzl::io::OutputSink sink(pipe.descriptor());
+	const auto report{dzl::pipeline::run(path, std::endian::native, sink)};
+	sink.flush();
+
+	REQUIRE(report.word_count == words.size());
+	REQUIRE(pipe.finish() == expected);
+	std::filesystem::remove(path);
+}
+
+// NOLINTEND(*-magic-numbers)
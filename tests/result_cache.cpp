@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+import result_cache;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+// Three chunks, with a literal loaded across the first chunk boundary
+auto make_words()
+{
+	std::vector<dzl::Word> words(3000, 0xE3A0'0001_u32);
+	words[1022] = 0xE59F'0000_u32; // ldr r0, [pc]
+	words[1024] = 0xE3A0'0002_u32;
+	return words;
+}
+
+auto disassemble(const std::span<const dzl::Word> t_words, dzl::cache::ResultCache& t_cache)
+{
+	std::string text;
+	dzl::cache::disassemble(t_words, 0x8000_add, t_cache, text);
+	return text;
+}
+
+auto entries(const std::filesystem::path& t_directory)
+{
+	std::vector<std::filesystem::path> paths;
+	for (const auto& entry : std::filesystem::directory_iterator(t_directory))
+	{
+		paths.push_back(entry.path());
+	}
+	std::ranges::sort(paths);
+	return paths;
+}
+
+} // namespace
+
+TEST_CASE("Cached output matches the disassembly of the whole image", "[cache::ResultCache]")
+{
+	const auto directory{dzl::test::temporary_path("result_cache")};
+	const auto words{make_words()};
+	std::string expected;
+	dzl::disassemble(words, expected);
+	REQUIRE(expected.contains(".word 0xe3a00002\n"));
+
+	{
+		dzl::cache::ResultCache cache(directory, 1ULL << 30U);
+		REQUIRE(disassemble(words, cache) == expected);
+		REQUIRE(cache.statistics().misses == 3);
+		REQUIRE(entries(directory).size() == 3);
+	}
+	{
+		dzl::cache::ResultCache cache(directory, 1ULL << 30U);
+		REQUIRE(disassemble(words, cache) == expected);
+		REQUIRE(cache.statistics().hits == 3);
+		REQUIRE(cache.statistics().misses == 0);
+	}
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Corrupt entries are misses", "[cache::ResultCache]")
+{
+	const auto directory{dzl::test::temporary_path("result_cache_corrupt")};
+	const auto words{make_words()};
+	std::string expected;
+	dzl::disassemble(words, expected);
+
+	{
+		dzl::cache::ResultCache cache(directory, 1ULL << 30U);
+		static_cast<void>(disassemble(words, cache));
+	}
+
+	const auto paths{entries(directory)};
+	REQUIRE(paths.size() == 3);
+
+	// Truncated text
+	std::filesystem::resize_file(paths[0], std::filesystem::file_size(paths[0]) - 10);
+
+	// A text size far beyond the end of the file, found as the size stored just before the text
+	{
+		std::fstream file(paths[1], std::ios::binary | std::ios::in | std::ios::out);
+		const std::string entry{std::istreambuf_iterator<char>(file), {}};
+
+		for (auto position{entry.size() - sizeof(std::uint64_t)}; position > 0; --position)
+		{
+			std::uint64_t size{};
+			std::memcpy(&size, entry.data() + position, sizeof(size));
+			if (size == entry.size() - position - sizeof(size))
+			{
+				const std::uint64_t corrupt_size{1ULL << 62U};
+				file.clear();
+				file.seekp(static_cast<std::streamoff>(position));
+				file.write(reinterpret_cast<const char*>(&corrupt_size), sizeof(corrupt_size));
+				break;
+			}
+		}
+	}
+
+	dzl::cache::ResultCache cache(directory, 1ULL << 30U);
+	REQUIRE(disassemble(words, cache) == expected);
+	REQUIRE(cache.statistics().hits == 1);
+	REQUIRE(cache.statistics().misses == 2);
+
+	std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("The least recently used entries are evicted beyond the size limit",
+		  "[cache::ResultCache]")
+{
+	const auto directory{dzl::test::temporary_path("result_cache_evict")};
+	const auto words{make_words()};
+
+	// Room for two entries of about 26 KB
+	constexpr std::uintmax_t size_limit{60'000};
+	dzl::cache::ResultCache cache(directory, size_limit);
+	static_cast<void>(disassemble(words, cache));
+
+	REQUIRE(cache.statistics().evictions > 0);
+
+	std::uintmax_t size{};
+	for (const auto& path : entries(directory))
+	{
+		size += std::filesystem::file_size(path);
+	}
+	REQUIRE(size <= size_limit);
+
+	std::filesystem::remove_all(directory);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "test_support.hpp"
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import disassembly;
+import listing;
+import server;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::server::OutputStyle;
+using dzl::server::Status;
+using dzl::test::lines;
+
+namespace
+{
+// Several chunks of instructions, so that windows can straddle them
+auto write_image(const std::filesystem::path& t_path) -> std::vector<dzl::Word>
+{
+	auto words{dzl::test::make_instructions(2500)};
+
+	std::ofstream file(t_path, std::ios::binary);
+	file.write(reinterpret_cast<const char*>(words.data()),
+			   static_cast<std::streamsize>(words.size() * sizeof(dzl::Word)));
+	return words;
+}
+
+// A daemon serving one image at 0x8000 for the duration of a test
+class TestServer
+{
+public:
+	TestServer()
+		: m_image_path(dzl::test::temporary_path("server_test.bin")),
+		  m_socket_path(dzl::test::temporary_path("server_test.sock")),
+		  m_words(write_image(m_image_path)),
+		  m_server(std::array{dzl::server::ImageSource{
+					   .path = m_image_path, .base = 0x8000_add, .endianness = std::endian::native}},
+				   {.socket_path = m_socket_path, .cache_size = 1UZ << 20U}),
+		  m_thread([this] { m_server.run(); })
+	{
+	}
+
+	TestServer(const TestServer&) = delete;
+	TestServer(TestServer&&) = delete;
+	auto operator=(const TestServer&) -> TestServer& = delete;
+	auto operator=(TestServer&&) -> TestServer& = delete;
+
+	~TestServer()
+	{
+		m_server.stop();
+		m_thread.join();
+		std::filesystem::remove(m_image_path);
+	}
+
+	[[nodiscard]] auto socket_path() const { return m_socket_path; }
+	[[nodiscard]] auto words() const -> std::span<const dzl::Word> { return m_words; }
+	[[nodiscard]] auto server() -> dzl::server::Server& { return m_server; }
+
+private:
+	std::filesystem::path m_image_path;
+	std::filesystem::path m_socket_path;
+	std::vector<dzl::Word> m_words;
+	dzl::server::Server m_server;
+	std::thread m_thread;
+};
+
+} // namespace
+
+TEST_CASE("Windows match the output of the whole image", "[server::Server]")
+{
+	TestServer server;
+	dzl::server::Client client(server.socket_path());
+
+	std::string plain;
+	dzl::disassemble(server.words(), plain);
+	std::string listing;
+	dzl::listing::list(server.words(), 0x8000_add, {.branch_targets = true}, listing);
+
+	// Within a chunk, across chunks and cut short by the end of the image
+	for (const auto [first, count] : {std::pair{0UZ, 10UZ}, std::pair{1000UZ, 100UZ},
+									  std::pair{2490UZ, 100UZ}})
+	{
+		const auto address{0x8000_add + dzl::AddressOffset(static_cast<std::uint32_t>(4 * first))};
+		const auto word_count{static_cast<std::uint32_t>(count)};
+
+		REQUIRE(client.disassemble(0, address, word_count) == lines(plain, first, count));
+		REQUIRE(client.disassemble(0, address, word_count, OutputStyle::ListingWithTargets) ==
+				lines(listing, first, count));
+	}
+}
+
+TEST_CASE("Repeated windows are served from formatted chunks", "[server::Server]")
+{
+	TestServer server;
+	dzl::server::Client client(server.socket_path());
+
+	const auto first{client.disassemble(0, 0x8000_add, 16)};
+	REQUIRE(client.disassemble(0, 0x8000_add, 16) == first);
+	REQUIRE(!client.disassemble(0, 0x8000_add, 16, OutputStyle::Listing).empty());
+
+	const auto statistics{server.server().statistics()};
+	REQUIRE(statistics.requests == 3);
+	REQUIRE(statistics.failed_requests == 0);
+	REQUIRE(statistics.chunk_hits == 1);
+	REQUIRE(statistics.chunk_misses == 2);
+	REQUIRE(statistics.p50 <= statistics.p99);
+	REQUIRE(statistics.p99 > std::chrono::nanoseconds::zero());
+
+	const auto report{client.statistics()};
+	REQUIRE(report.starts_with("requests 3\nfailed_requests 0\nchunk_hits 1\nchunk_misses 2\n"));
+	REQUIRE(report.contains("p99_us "));
+	REQUIRE(report.contains("failed_accepts 0\n"));
+}
+
+TEST_CASE("Clients that disconnect at once do not stop the daemon", "[server::Server]")
+{
+	TestServer server;
+	for (std::size_t i_client{}; i_client < 50; ++i_client)
+	{
+		const dzl::server::Client client(server.socket_path());
+	}
+
+	std::string plain;
+	dzl::disassemble(server.words(), plain);
+	dzl::server::Client client(server.socket_path());
+	REQUIRE(client.disassemble(0, 0x8000_add, 4) == lines(plain, 0, 4));
+	REQUIRE(server.server().statistics().requests == 1);
+}
+
+TEST_CASE("Invalid requests are answered with an error status", "[server::Server]")
+{
+	TestServer server;
+	dzl::server::Client client(server.socket_path());
+
+	REQUIRE(client.send({.kind = dzl::server::RequestKind::Disassemble, .image = 1}).first ==
+			Status::UnknownImage);
+	REQUIRE(client.send({.kind = dzl::server::RequestKind::Disassemble, .address = 0x4000})
+				.first == Status::OutOfRange);
+	REQUIRE(client.send({.kind = dzl::server::RequestKind::Disassemble, .address = 0x8002})
+				.first == Status::OutOfRange);
+	REQUIRE(client.send({.kind = dzl::server::RequestKind::Disassemble,
+						 .address = 0x8000,
+						 .word_count = dzl::server::max_request_word_count + 1})
+				.first == Status::BadRequest);
+	REQUIRE(client.send({.magic = 0, .kind = dzl::server::RequestKind::Statistics}).first ==
+			Status::BadRequest);
+	REQUIRE_THROWS_AS(client.disassemble(2, 0x8000_add, 1), std::runtime_error);
+
+	// The connection survives failed requests
+	REQUIRE(client.disassemble(0, 0x8000_add, 1) == "mov r0, #0x1\n");
+	REQUIRE(server.server().statistics().failed_requests == 6);
+}
+
+TEST_CASE("A shutdown request stops the daemon", "[server::Server]")
+{
+	const auto image_path{dzl::test::temporary_path("server_shutdown.bin")};
+	const auto socket_path{dzl::test::temporary_path("server_shutdown.sock")};
+	static_cast<void>(write_image(image_path));
+
+	{
+		dzl::server::Server server(
+			std::array{dzl::server::ImageSource{
+				.path = image_path, .base = 0x8000_add, .endianness = std::endian::native}},
+			{.socket_path = socket_path});
+		std::thread thread([&] { server.run(); });
+
+		dzl::server::Client(socket_path).shutdown();
+		thread.join();
+	}
+
+	REQUIRE(!std::filesystem::exists(socket_path));
+	std::filesystem::remove(image_path);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,208 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+import symbol_table;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::Address;
+using dzl::symbols::Symbol;
+using dzl::symbols::SymbolTable;
+
+namespace
+{
+auto describe(const SymbolTable& t_table, const std::uint32_t t_address) -> std::string
+{
+	const auto reference{t_table.find(Address(t_address))};
+	return reference ? std::format("{}", *reference) : "";
+}
+
+// ELF32 with a null section, .symtab and .strtab
+auto make_elf(const std::endian t_endianness) -> std::vector<std::byte>
+{
+	constexpr std::string_view strings{"\0main\0helper\0$a\0external\0table\0", 31};
+	constexpr std::size_t strings_offset{52};
+	constexpr std::size_t symbols_offset{strings_offset + strings.size()};
+	constexpr std::size_t symbol_count{6};
+	constexpr std::size_t sections_offset{symbols_offset + (symbol_count * 16)};
+
+	std::vector<std::byte> bytes(sections_offset + (3 * 40));
+	const auto put{[&](const std::size_t t_offset, const std::unsigned_integral auto t_value)
+				   {
+					   const auto value{t_endianness == std::endian::native ? t_value
+																			: std::byteswap(t_value)};
+					   std::memcpy(bytes.data() + t_offset, &value, sizeof(value));
+				   }};
+
+	const std::uint8_t byte_order{t_endianness == std::endian::big ? std::uint8_t{2}
+																   : std::uint8_t{1}};
+	std::ranges::copy(std::array<std::uint8_t, 6>{0x7F, 'E', 'L', 'F', 1, byte_order},
+					  reinterpret_cast<std::uint8_t*>(bytes.data()));
+	put(32, std::uint32_t{sections_offset});
+	put(46, std::uint16_t{40});
+	put(48, std::uint16_t{3});
+
+	std::ranges::copy(strings, reinterpret_cast<char*>(bytes.data() + strings_offset));
+
+	// Name, value, type and section of each symbol
+	const std::array<std::tuple<std::uint32_t, std::uint32_t, std::uint8_t, std::uint16_t>,
+					 symbol_count>
+		symbols{{
+			{0, 0, 0, 0},		   // Null symbol
+			{1, 0x8001, 0x12, 1},  // Global Thumb function main
+			{6, 0x8100, 0x02, 1},  // Local function helper
+			{13, 0x8000, 0x00, 1}, // Mapping symbol
+			{16, 0x0, 0x12, 0},	   // Undefined function
+			{25, 0x9000, 0x01, 1}, // Object
+		}};
+	for (std::size_t i_symbol{}; i_symbol < symbols.size(); ++i_symbol)
+	{
+		const auto [name, value, info, section]{symbols[i_symbol]};
+		const auto symbol{symbols_offset + (i_symbol * 16)};
+		put(symbol, name);
+		put(symbol + 4, value);
+		bytes[symbol + 12] = std::byte{info};
+		put(symbol + 14, section);
+	}
+
+	// .symtab, linked to .strtab
+	put(sections_offset + 40 + 4, std::uint32_t{2});
+	put(sections_offset + 40 + 16, std::uint32_t{symbols_offset});
+	put(sections_offset + 40 + 20, std::uint32_t{symbol_count * 16});
+	put(sections_offset + 40 + 24, std::uint32_t{2});
+	put(sections_offset + 40 + 36, std::uint32_t{16});
+
+	// .strtab
+	put(sections_offset + 80 + 4, std::uint32_t{3});
+	put(sections_offset + 80 + 16, std::uint32_t{strings_offset});
+	put(sections_offset + 80 + 20, std::uint32_t{strings.size()});
+
+	return bytes;
+}
+
+} // namespace
+
+TEST_CASE("Addresses resolve to the symbol at or before them", "[symbols::SymbolTable]")
+{
+	const std::array symbols{
+		Symbol{.address = Address(0x8100U), .name = "helper"},
+		Symbol{.address = Address(0x8000U), .name = "main"},
+		Symbol{.address = Address(0x8200U), .name = "exit"},
+	};
+	const SymbolTable table(symbols);
+
+	REQUIRE(table.size() == 3);
+	REQUIRE(table[0].name == "main");
+	REQUIRE(table[2].address.get() == 0x8200U);
+
+	REQUIRE(describe(table, 0x7FFC) == "");
+	REQUIRE(describe(table, 0x8000) == "main");
+	REQUIRE(describe(table, 0x801C) == "main+0x1c");
+	REQUIRE(describe(table, 0x8100) == "helper");
+	REQUIRE(describe(table, 0x81FC) == "helper+0xfc");
+	REQUIRE(describe(table, 0xFFFF'FFFC) == "exit+0xffff7dfc");
+
+	REQUIRE(!SymbolTable().find(Address(0x8000U)));
+}
+
+TEST_CASE("Duplicate addresses keep the first symbol and names are stored once",
+		  "[symbols::SymbolTable]")
+{
+	const std::array symbols{
+		Symbol{.address = Address(0x10U), .name = "start"},
+		Symbol{.address = Address(0x10U), .name = "alias"},
+		Symbol{.address = Address(0x20U), .name = "loop"},
+		Symbol{.address = Address(0x30U), .name = "loop"},
+	};
+	const SymbolTable table(symbols);
+
+	REQUIRE(table.size() == 3);
+	REQUIRE(describe(table, 0x14) == "start+0x4");
+	REQUIRE(table.name_blob() == "startloop");
+	REQUIRE(table[1].name.data() == table[2].name.data());
+}
+
+TEST_CASE("Lookups agree with an ordered map", "[symbols::SymbolTable]")
+{
+	std::mt19937 generator(1729);
+
+	for (const std::size_t symbol_count : {1UZ, 2UZ, 7UZ, 8UZ, 100UZ, 5000UZ})
+	{
+		std::map<std::uint32_t, std::string> expected;
+		while (expected.size() < symbol_count)
+		{
+			const auto address{static_cast<std::uint32_t>(generator() % (symbol_count * 64)) * 4U};
+			expected.emplace(address, std::format("sub_{:08x}", address));
+		}
+
+		std::vector<Symbol> symbols;
+		for (const auto& [address, name] : expected)
+		{
+			symbols.push_back(Symbol{.address = Address(address), .name = name});
+		}
+		std::ranges::shuffle(symbols, generator);
+		const SymbolTable table(symbols);
+
+		for (std::size_t i_lookup{}; i_lookup < 1000; ++i_lookup)
+		{
+			const auto address{static_cast<std::uint32_t>(generator() % (symbol_count * 320))};
+			const auto reference{table.find(Address(address))};
+
+			const auto next{expected.upper_bound(address)};
+			if (next == expected.begin())
+			{
+				REQUIRE(!reference);
+				continue;
+			}
+
+			const auto& [start, name]{*std::prev(next)};
+			REQUIRE(reference);
+			REQUIRE(reference->name == name);
+			REQUIRE(reference->offset.get() == address - start);
+		}
+	}
+}
+
+TEST_CASE("Map files list an address and a name per line", "[symbols::parse_map]")
+{
+	const auto table{dzl::symbols::parse_map("# Linker map\n"
+											 "00008000 main\n"
+											 "0x8100  helper\r\n"
+											 "\n"
+											 "00008200 T exit\n")};
+
+	REQUIRE(table.size() == 3);
+	REQUIRE(describe(table, 0x8004) == "main+0x4");
+	REQUIRE(describe(table, 0x8100) == "helper");
+	REQUIRE(describe(table, 0x8208) == "exit+0x8");
+
+	REQUIRE_THROWS_AS(dzl::symbols::parse_map("main 00008000\n"), std::runtime_error);
+	REQUIRE_THROWS_AS(dzl::symbols::parse_map("00008000\n"), std::runtime_error);
+}
+
+TEST_CASE("ELF32 symbol tables keep defined functions and labels", "[symbols::parse_elf]")
+{
+	for (const auto endianness : {std::endian::little, std::endian::big})
+	{
+		const auto elf{make_elf(endianness)};
+		REQUIRE(dzl::symbols::is_elf(elf));
+
+		const auto table{dzl::symbols::parse_elf(elf)};
+
+		// Neither the mapping symbol, the undefined function nor the object
+		REQUIRE(table.size() == 2);
+		REQUIRE(describe(table, 0x8000) == "main");
+		REQUIRE(describe(table, 0x8104) == "helper+0x4");
+		REQUIRE(describe(table, 0x9000) == "helper+0xf00");
+	}
+
+	auto truncated{make_elf(std::endian::little)};
+	truncated.resize(100);
+	REQUIRE_THROWS_AS(dzl::symbols::parse_elf(truncated), std::runtime_error);
+}
+
+// NOLINTEND(*-magic-numbers)
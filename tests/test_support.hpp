@@ -0,0 +1,119 @@
+#pragma once
+
+#include <unistd.h>
+
+import std;
+
+import unsigned_integer;
+
+import types;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace dzl::test
+{
+// Unique to this process, so that test runs in parallel do not collide
+inline auto temporary_path(const std::string_view t_name) -> std::filesystem::path
+{
+	return std::filesystem::temp_directory_path() / std::format("dzl_{}_{}", ::getpid(), t_name);
+}
+
+constexpr std::array instruction_words{
+	0xE3A0'0001_u32, // mov r0, #0x1
+	0xE081'1002_u32, // add r1, r1, r2
+	0xE351'0FFF_u32, // cmp r1, #0x3fc
+	0xEB00'0004_u32, // bl 0x10
+	0xE12F'FF1E_u32, // bx lr
+};
+
+// t_count words cycling through instruction_words
+inline auto make_instructions(const std::size_t t_count) -> std::vector<Word>
+{
+	std::vector<Word> words;
+	words.reserve(t_count);
+	for (std::size_t i_word{}; i_word < t_count; ++i_word)
+	{
+		words.push_back(instruction_words[i_word % instruction_words.size()]);
+	}
+	return words;
+}
+
+// Lines t_first to t_first + t_count of t_text
+inline auto lines(const std::string_view t_text, const std::size_t t_first,
+				  const std::size_t t_count) -> std::string
+{
+	std::string result;
+	for (const auto line : t_text | std::views::split('\n') | std::views::drop(t_first) |
+							   std::views::take(t_count))
+	{
+		if (line.empty())
+		{
+			break;
+		}
+		result.append(std::string_view(line.begin(), line.end()));
+		result.push_back('\n');
+	}
+	return result;
+}
+
+/*
+	Collects what is written to a pipe on another thread, so that writers never wait for good
+*/
+class PipeReader
+{
+public:
+	// A small t_read_size makes the writer wait on the reader
+	explicit PipeReader(const std::size_t t_read_size = 65536)
+	{
+		if (::pipe(m_descriptors.data()) != 0)
+		{
+			throw std::runtime_error("Cannot create a pipe");
+		}
+
+		m_reader = std::thread(
+			[this, t_read_size]
+			{
+				std::vector<char> buffer(t_read_size);
+				for (auto size{::read(m_descriptors[0], buffer.data(), buffer.size())}; size > 0;
+					 size = ::read(m_descriptors[0], buffer.data(), buffer.size()))
+				{
+					m_text.append(buffer.data(), static_cast<std::size_t>(size));
+				}
+			});
+	}
+
+	PipeReader(const PipeReader&) = delete;
+	PipeReader(PipeReader&&) = delete;
+	auto operator=(const PipeReader&) -> PipeReader& = delete;
+	auto operator=(PipeReader&&) -> PipeReader& = delete;
+
+	~PipeReader()
+	{
+		static_cast<void>(finish());
+		::close(m_descriptors[0]);
+	}
+
+	// Write end
+	[[nodiscard]] auto descriptor() const noexcept { return m_descriptors[1]; }
+
+	// Closes the write end and returns everything read. Spliced pages must stay untouched until
+	// then, so writers outlive this call.
+	[[nodiscard]] auto finish() -> std::string
+	{
+		if (m_reader.joinable())
+		{
+			::close(m_descriptors[1]);
+			m_reader.join();
+		}
+		return m_text;
+	}
+
+private:
+	std::array<int, 2> m_descriptors{};
+	std::string m_text;
+	std::thread m_reader;
+};
+
+} // namespace dzl::test
+
+// NOLINTEND(*-magic-numbers)
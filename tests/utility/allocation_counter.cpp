@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import unsigned_integer;
+import allocation_counter;
+import text_arena;
+
+import types;
+import instruction;
+import arm_instruction;
+import instruction_formatting;
+import disassembly;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+using dzl::memory::count_allocations;
+
+namespace
+{
+constexpr std::array data_processing_words{
+	0xE3A0'0001_u32, // mov r0, #0x1
+	0xE081'1002_u32, // add r1, r1, r2
+	0xE351'0FFF_u32, // cmp r1, #0x3fc
+	0xE181'1312_u32, // orr r1, r1, r2, lsl r3
+	0xE1A0'1060_u32, // mov r1, r0, rrx
+	0xE1A0'F00E_u32, // mov pc, lr
+};
+
+// Allocations of a second formatting pass, after any one-time setup of the first
+auto format_allocations(const auto& t_value) -> std::size_t
+{
+	std::array<char, 256> buffer{};
+	const auto format{
+		[&] { static_cast<void>(std::format_to_n(buffer.data(), buffer.size(), "{}", t_value)); }};
+
+	format();
+	return count_allocations(format).allocations;
+}
+
+auto require_counting() -> void
+{
+	if (!dzl::memory::allocation_counting)
+	{
+		SKIP("Built without ARM_DISASSEMBLER_COUNT_ALLOCATIONS");
+	}
+}
+
+} // namespace
+
+TEST_CASE("Allocations of the calling thread are counted", "[allocation_counter]")
+{
+	require_counting();
+
+	// Kept alive past the count, so that the allocations cannot be elided
+	std::vector<std::uint64_t> values;
+	std::unique_ptr<std::vector<std::uint64_t>> copy;
+
+	const auto count{count_allocations(
+		[&]
+		{
+			values.resize(100);
+			copy = std::make_unique<std::vector<std::uint64_t>>(values);
+		})};
+
+	REQUIRE(count.allocations == 3);
+	REQUIRE(count.deallocations == 0);
+	REQUIRE(count.bytes >= 2 * 100 * sizeof(std::uint64_t));
+	REQUIRE(copy->size() == values.size());
+}
+
+TEST_CASE("Other threads only count towards the process", "[allocation_counter]")
+{
+	require_counting();
+
+	const auto process_before{dzl::memory::process_allocations()};
+
+	std::unique_ptr<int> value;
+	const auto count{count_allocations(
+		[&] { std::jthread worker([&] { value = std::make_unique<int>(1); }); })};
+
+	// Starting the thread may allocate, but the worker's int is not the caller's
+	REQUIRE(dzl::memory::process_allocations().allocations - process_before.allocations >=
+			count.allocations + 1);
+	REQUIRE(*value == 1);
+}
+
+TEST_CASE("Decoding does not allocate", "[allocation_counter][budget]")
+{
+	require_counting();
+
+	for (const auto word : data_processing_words)
+	{
+		const auto count{count_allocations([&] { static_cast<void>(dzl::fmt::arm::decode(word)); })};
+		REQUIRE(count.allocations == 0);
+	}
+}
+
+TEST_CASE("Formatters do not allocate", "[allocation_counter][budget]")
+{
+	require_counting();
+
+	for (const auto word : data_processing_words)
+	{
+		const auto instruction{dzl::fmt::arm::decode(word)};
+		const auto data_processing{instruction.get<dzl::ins::DataProcessing>()};
+		const auto [operation, condition, op_code, set_condition_codes, destination, first,
+					second]{data_processing};
+
+		REQUIRE(format_allocations(instruction) == 0);
+		REQUIRE(format_allocations(data_processing) == 0);
+		REQUIRE(format_allocations(second) == 0);
+		REQUIRE(format_allocations(destination) == 0);
+		REQUIRE(format_allocations(condition) == 0);
+	}
+
+	REQUIRE(format_allocations(dzl::fmt::arm::decode(0xEB00'0004_u32)) == 0); // bl
+	REQUIRE(format_allocations(dzl::fmt::arm::decode(0xE12F'FF1E_u32)) == 0); // bx lr
+	REQUIRE(format_allocations(dzl::fmt::arm::decode(0xE10F'0000_u32)) == 0); // mrs
+	REQUIRE(format_allocations(dzl::fmt::arm::decode(0xE128'F000_u32)) == 0); // msr
+
+	const dzl::ins::Instruction multiply(
+		dzl::ins::Multiply(dzl::ins::Operation::Multiply, dzl::Condition::Al, dzl::Register::R1,
+						   dzl::Register::R0, dzl::Register::R2, dzl::Register::R3, false, true,
+						   true, true));
+	REQUIRE(format_allocations(multiply) == 0);
+}
+
+TEST_CASE("Disassembling into a warm arena does not allocate", "[allocation_counter][budget]")
+{
+	require_counting();
+
+	TextArena text;
+	const auto disassemble{[&]
+						   {
+							   text.reset();
+							   for (const auto word : data_processing_words)
+							   {
+								   static_cast<void>(dzl::format_decoded(
+									   dzl::fmt::arm::try_decode(word), word, text));
+							   }
+						   }};
+
+	disassemble();
+	REQUIRE(count_allocations(disassemble).allocations == 0);
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+import std;
+
 import unsigned_integer;
 import bit_manipulation;
 
@@ -128,4 +130,127 @@ TEST_CASE("", "[sign_extend]")
 	STATIC_REQUIRE(sign_extend(0x1729_u16, 0_bs) == 0x0000_u16);
 }
 
+namespace
+{
+// Odd length, so every vector width leaves a scalar remainder
+auto random_words() -> std::vector<Unsigned<4>>
+{
+	std::mt19937 generator(1729);
+	std::vector<Unsigned<4>> words(1003);
+	std::ranges::generate(words, [&] { return Unsigned<4>(static_cast<std::uint32_t>(generator())); });
+	return words;
+}
+} // namespace
+
+TEST_CASE("", "[get_bits(batch)]")
+{
+	STATIC_REQUIRE(
+		[]
+		{
+			const std::array values{0x1729_u16, 0xABCD_u16, 0x0001_u16};
+			std::array<Unsigned<2>, 3> results{};
+			get_bits(values, {4_bi, 8_bs}, results);
+			return results == std::array{0x0072_u16, 0x00BC_u16, 0x0000_u16};
+		}());
+
+	const auto values{random_words()};
+	std::vector<Unsigned<4>> results(values.size());
+
+	for (const auto range : {BitRange(0_bi, 24_bs), BitRange(16_bi, 4_bs), BitRange(28_bi, 4_bs),
+							 BitRange(5_bi, 32_bs), BitRange(0_bi, 32_bs), BitRange(32_bi, 4_bs)})
+	{
+		get_bits(values, range, results);
+
+		std::size_t mismatches{};
+		for (std::size_t i_value{}; i_value < values.size(); ++i_value)
+		{
+			mismatches += results[i_value] != get_bits(values[i_value], range) ? 1 : 0;
+		}
+		REQUIRE(mismatches == 0);
+	}
+
+	get_bits<UbChecked::Unchecked>(values, {8_bi, 12_bs}, results);
+	REQUIRE(results[7] == get_bits<UbChecked::Unchecked>(values[7], {8_bi, 12_bs}));
+
+	std::vector<Unsigned<4>> too_small(values.size() - 1);
+	REQUIRE_THROWS_AS(get_bits(values, {0_bi, 8_bs}, too_small), std::invalid_argument);
+}
+
+TEST_CASE("", "[set_bits(batch)]")
+{
+	const auto sources{random_words()};
+	const auto original{[] { return std::vector<Unsigned<4>>(1003, 0x1729ABCD_u32); }};
+
+	for (const auto range : {BitRange(0_bi, 24_bs), BitRange(16_bi, 4_bs), BitRange(28_bi, 8_bs),
+							 BitRange(0_bi, 32_bs), BitRange(32_bi, 4_bs)})
+	{
+		auto destinations{original()};
+		set_bits(destinations, sources, range);
+
+		std::size_t mismatches{};
+		for (std::size_t i_value{}; i_value < sources.size(); ++i_value)
+		{
+			auto expected{0x1729ABCD_u32};
+			if (range.begin().get() < 32)
+			{
+				set_bits(expected, sources[i_value], range);
+			}
+			mismatches += destinations[i_value] != expected ? 1 : 0;
+		}
+		REQUIRE(mismatches == 0);
+	}
+}
+
+TEST_CASE("", "[sign_extend(batch)]")
+{
+	const auto values{random_words()};
+	std::vector<Unsigned<4>> results(values.size());
+
+	for (const auto width : {24_bs, 12_bs, 1_bs, 31_bs, 32_bs, 0_bs})
+	{
+		sign_extend(values, width, results);
+
+		std::size_t mismatches{};
+		for (std::size_t i_value{}; i_value < values.size(); ++i_value)
+		{
+			mismatches += results[i_value] != sign_extend(values[i_value], width) ? 1 : 0;
+		}
+		REQUIRE(mismatches == 0);
+	}
+}
+
+TEST_CASE("", "[rotate_right(batch)]")
+{
+	const auto values{random_words()};
+	std::vector<Unsigned<4>> results(values.size());
+
+	for (const std::uint8_t amount : {0, 1, 2, 16, 30, 31, 32, 40})
+	{
+		rotate_right(values, BitShiftAmount(amount), results);
+
+		std::size_t mismatches{};
+		for (std::size_t i_value{}; i_value < values.size(); ++i_value)
+		{
+			mismatches +=
+				results[i_value] != rotate_right(values[i_value], BitShiftAmount(amount)) ? 1 : 0;
+		}
+		REQUIRE(mismatches == 0);
+	}
+
+	// Per-value amounts, as for rotated immediates
+	std::vector<BitShiftAmount> amounts(values.size());
+	for (std::size_t i_value{}; i_value < values.size(); ++i_value)
+	{
+		amounts[i_value] = BitShiftAmount(static_cast<std::uint8_t>((i_value * 2) % 40));
+	}
+	rotate_right(values, amounts, results);
+
+	std::size_t mismatches{};
+	for (std::size_t i_value{}; i_value < values.size(); ++i_value)
+	{
+		mismatches += results[i_value] != rotate_right(values[i_value], amounts[i_value]) ? 1 : 0;
+	}
+	REQUIRE(mismatches == 0);
+}
+
 // NOLINTEND(*-magic-numbers)
\ No newline at end of file
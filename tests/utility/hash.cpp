@@ -0,0 +1,28 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import hash;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("xxhash64 matches the reference implementation", "[xxhash64]")
+{
+	STATIC_REQUIRE(xxhash64({}) == 0xEF46DB37'51D8E999);
+
+	{
+		const auto text{std::as_bytes(std::span(std::string_view("abc")))};
+		REQUIRE(xxhash64(text) == 0x44BC2CF5'AD770999);
+	}
+
+	std::array<std::byte, 64> sequence{};
+	for (std::size_t i_byte{}; i_byte < sequence.size(); ++i_byte)
+	{
+		sequence[i_byte] = static_cast<std::byte>(i_byte);
+	}
+
+	REQUIRE(xxhash64(sequence) == 0xF7C67301'DB6713F0);
+	REQUIRE(xxhash64(sequence, 0x1729) == 0x4B528652'844608EB);
+}
+
+// NOLINTEND(*-magic-numbers)
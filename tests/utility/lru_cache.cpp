@@ -0,0 +1,50 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import lru_cache;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+namespace
+{
+auto insert(LruCache<int, std::string>& t_cache, const int t_key, const std::string& t_value)
+{
+	return t_cache.insert(t_key, std::make_shared<const std::string>(t_value), t_value.size());
+}
+
+} // namespace
+
+TEST_CASE("The least recently used values are evicted first", "[LruCache]")
+{
+	LruCache<int, std::string> cache(10);
+
+	REQUIRE(insert(cache, 1, "aaaa") == 0);
+	REQUIRE(insert(cache, 2, "bbbb") == 0);
+
+	// Using 1 leaves 2 as the oldest
+	REQUIRE(*cache.find(1) == "aaaa");
+	REQUIRE(insert(cache, 3, "cccc") == 1);
+
+	REQUIRE(cache.contains(1));
+	REQUIRE(!cache.contains(2));
+	REQUIRE(cache.find(2) == nullptr);
+	REQUIRE(cache.contains(3));
+	REQUIRE(cache.size() == 8);
+	REQUIRE(cache.count() == 2);
+}
+
+TEST_CASE("Existing values stay and oversized values are kept alone", "[LruCache]")
+{
+	LruCache<int, std::string> cache(10);
+
+	REQUIRE(insert(cache, 1, "aaaa") == 0);
+	REQUIRE(insert(cache, 1, "other") == 0);
+	REQUIRE(*cache.find(1) == "aaaa");
+
+	REQUIRE(insert(cache, 2, "a value larger than the limit") == 1);
+	REQUIRE(cache.count() == 1);
+	REQUIRE(cache.contains(2));
+}
+
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import spsc_queue;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Values arrive in order across threads", "[SpscQueue]")
+{
+	constexpr std::size_t value_count{100'000};
+	SpscQueue<std::size_t, 4> queue;
+
+	std::jthread producer(
+		[&]
+		{
+			for (std::size_t i_value{}; i_value < value_count; ++i_value)
+			{
+				queue.push(i_value);
+			}
+		});
+
+	std::size_t out_of_order{};
+	for (std::size_t i_value{}; i_value < value_count; ++i_value)
+	{
+		out_of_order += queue.pop() != i_value ? 1 : 0;
+	}
+	REQUIRE(out_of_order == 0);
+}
+
+TEST_CASE("Move-only values are moved through", "[SpscQueue]")
+{
+	SpscQueue<std::unique_ptr<int>, 2> queue;
+	queue.push(std::make_unique<int>(7));
+	queue.push(nullptr);
+
+	REQUIRE(*queue.pop() == 7);
+	REQUIRE(queue.pop() == nullptr);
+}
+
+// NOLINTEND(*-magic-numbers)
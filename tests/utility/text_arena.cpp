@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import text_arena;
+
+// NOLINTBEGIN(*-magic-numbers)
+
+TEST_CASE("Formatted text stays valid while the arena grows", "[TextArena]")
+{
+	TextArena arena(64);
+
+	std::vector<std::string_view> lines;
+	for (std::size_t i_line{}; i_line < 100; ++i_line)
+	{
+		lines.push_back(arena.format("line {:03}\n", i_line));
+	}
+
+	REQUIRE(arena.block_count() > 1);
+	REQUIRE(lines[0] == "line 000\n");
+	REQUIRE(lines[42] == "line 042\n");
+	REQUIRE(lines[99] == "line 099\n");
+	REQUIRE(arena.size() == 900);
+}
+
+TEST_CASE("Blocks concatenate to the appended text", "[TextArena]")
+{
+	TextArena arena(16);
+
+	std::string expected;
+	for (std::size_t i_line{}; i_line < 50; ++i_line)
+	{
+		const auto line{std::format("{:#x}\n", i_line * 977)};
+		expected += line;
+		REQUIRE(arena.append(line) == line);
+	}
+
+	std::string joined;
+	for (const auto block : arena.blocks())
+	{
+		joined += block;
+	}
+	REQUIRE(joined == expected);
+}
+
+TEST_CASE("Resetting reuses the allocated blocks", "[TextArena]")
+{
+	TextArena arena(32);
+
+	const auto fill{[&]
+					{
+						for (std::size_t i_line{}; i_line < 40; ++i_line)
+						{
+							static_cast<void>(arena.format("{} {}\n", "mov", i_line));
+						}
+					}};
+
+	fill();
+	const auto block_count{arena.block_count()};
+	const auto size{arena.size()};
+
+	arena.reset();
+	REQUIRE(arena.size() == 0);
+	REQUIRE(std::ranges::empty(arena.blocks()));
+
+	fill();
+	REQUIRE(arena.block_count() == block_count);
+	REQUIRE(arena.size() == size);
+}
+
+TEST_CASE("Text larger than a block gets a block of its own", "[TextArena]")
+{
+	TextArena arena(8);
+
+	const auto small{arena.append("abc")};
+	const std::string large(100, 'x');
+	const auto copied{arena.format("{}", large)};
+	const auto after{arena.append("def")};
+
+	REQUIRE(small == "abc");
+	REQUIRE(copied == large);
+	REQUIRE(after == "def");
+	REQUIRE(arena.size() == 106);
+}
+
+TEST_CASE("Empty blocks are rejected", "[TextArena]")
+{
+	REQUIRE_THROWS_AS(TextArena(0), std::invalid_argument);
+}
+
+// NOLINTEND(*-magic-numbers)